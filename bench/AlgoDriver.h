@@ -0,0 +1,78 @@
+/**
+ * @file AlgoDriver.h
+ * @brief Drives a PagingAlgorithm directly, the way Simulation does, without TLB or logging.
+ */
+#ifndef BENCH_ALGODRIVER_H
+#define BENCH_ALGODRIVER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "core/PagingAlgorithm.h"
+
+namespace bench {
+
+/**
+ * @brief Minimal residency model around a replacement policy.
+ * @details Calls the policy hooks in the same order as Simulation:
+ *          hit -> [onWrite] memoryAccess; fault -> [selectVictimPage]
+ *          pageLoaded, memoryAccess, [onWrite]. Free frames are handed out
+ *          in ascending order. Victim frames are recorded if requested.
+ */
+class AlgoDriver {
+public:
+    AlgoDriver(PagingAlgorithm& algo, int numFrames, int numPages, bool recordVictims = false)
+        : algo_(algo), frameOfPage_(numPages, -1), pageOfFrame_(numFrames, -1),
+          record_(recordVictims) {}
+
+    void access(int page, bool write) {
+        int frame = frameOfPage_[page];
+        if (frame != -1) {
+            if (write) algo_.onWrite(page);
+            algo_.memoryAccess(page);
+            return;
+        }
+        ++faults_;
+        if (used_ < static_cast<int>(pageOfFrame_.size())) {
+            frame = used_++;
+        } else {
+            frame = algo_.selectVictimPage();
+            frameOfPage_[pageOfFrame_[frame]] = -1;
+            if (record_) victims_.push_back(frame);
+        }
+        pageOfFrame_[frame] = page;
+        frameOfPage_[page]  = frame;
+        algo_.pageLoaded(page, frame);
+        algo_.memoryAccess(page);
+        if (write) algo_.onWrite(page);
+    }
+
+    std::uint64_t faults() const { return faults_; }
+    const std::vector<int>& victims() const { return victims_; }
+
+private:
+    PagingAlgorithm&  algo_;
+    std::vector<int>  frameOfPage_;
+    std::vector<int>  pageOfFrame_;
+    int               used_{0};
+    std::uint64_t     faults_{0};
+    bool              record_;
+    std::vector<int>  victims_;
+};
+
+/**
+ * @brief Reproducible access stream with locality: mostly a hot set, sometimes anywhere.
+ * @param i Access index.
+ * @param numPages Page range.
+ * @param hotPages Size of the hot set (<= numPages).
+ */
+inline int localityPage(std::uint64_t i, int numPages, int hotPages) {
+    std::uint64_t x = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 31; x *= 0xBF58476D1CE4E5B9ULL; x ^= x >> 29;
+    const bool hot = (x & 7) != 0; // 7/8 of the accesses go to the hot set
+    return static_cast<int>((x >> 8) % static_cast<std::uint64_t>(hot ? hotPages : numPages));
+}
+
+} // namespace bench
+
+#endif // BENCH_ALGODRIVER_H
@@ -0,0 +1,65 @@
+/**
+ * @file BenchUtil.h
+ * @brief Small timing helpers shared by the benchmark executables.
+ */
+#ifndef BENCH_BENCHUTIL_H
+#define BENCH_BENCHUTIL_H
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench {
+
+/**
+ * @brief Run @p fn once and return the elapsed wall time in seconds.
+ */
+template <class Fn>
+double timeSeconds(Fn&& fn) {
+    const auto t0 = std::chrono::steady_clock::now();
+    fn();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+/**
+ * @brief Print one result line: label, items/sec and ns per item.
+ * @param label   Name of the measured configuration.
+ * @param items   Number of processed items (accesses, bytes, ...).
+ * @param seconds Elapsed time.
+ * @param unit    Unit name for the rate column.
+ */
+inline void report(const std::string& label, std::uint64_t items, double seconds,
+                   const char* unit = "accesses") {
+    const double rate = seconds > 0 ? items / seconds : 0.0;
+    const double ns   = items ? seconds * 1e9 / items : 0.0;
+    std::cout << std::left << std::setw(36) << label << std::right
+              << std::setw(14) << std::fixed << std::setprecision(0) << rate << ' ' << unit << "/s"
+              << std::setw(10) << std::setprecision(2) << ns << " ns/item\n";
+}
+
+/**
+ * @brief Print one throughput line in MB/s.
+ * @param label   Name of the measured configuration.
+ * @param bytes   Number of processed bytes.
+ * @param seconds Elapsed time.
+ */
+inline void reportThroughput(const std::string& label, std::uint64_t bytes, double seconds) {
+    const double mbps = seconds > 0 ? bytes / seconds / 1e6 : 0.0;
+    std::cout << std::left << std::setw(36) << label << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << mbps << " MB/s\n";
+}
+
+/**
+ * @brief Keep the optimizer from discarding a computed value.
+ */
+template <class T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace bench
+
+#endif // BENCH_BENCHUTIL_H
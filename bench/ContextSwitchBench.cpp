@@ -0,0 +1,115 @@
+/**
+ * @file ContextSwitchBench.cpp
+ * @brief Many interleaved processes: ASID-tagged TLB vs. flush on every switch.
+ *
+ * Processes run in short time slices over small hot sets. The ASID variant
+ * routes accesses through the simulation's process table (no flush); the
+ * flush variant clears the TLB with setCurrentProcess on every switch, as
+ * before the process table existed. Both must see the same page faults,
+ * since flushing only affects the TLB.
+ *
+ * Also churns processes: short-lived radix processes whose page counts add up
+ * to far more than INT_MAX are created and removed in turn, and every one of
+ * them must fault the same way as the first.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "Simulation.h"
+#include "core/algorithms/LRUAlgorithm.h"
+
+namespace {
+
+constexpr int kPagesPerProcess = 256;
+constexpr int kHotPages        = 16;
+constexpr int kSlice           = 64;  ///< Accesses per time slice.
+
+MemoryAccessEvent accessAt(std::uint64_t i, int processes) {
+    const auto pid = static_cast<unsigned char>(bench::localityPage(i / kSlice, processes, processes));
+    const int page = bench::localityPage(i, kPagesPerProcess, kHotPages);
+    return MemoryAccessEvent(page, (i & 3) == 0, pid);
+}
+
+TLBConfig tlbConfig() { return TLBConfig{256, 4, TLBReplacement::LRU}; }
+
+/** @return True if process churn never runs out of room and every generation faults alike. */
+bool checkChurn() {
+    constexpr std::uint64_t kChurnPages  = std::uint64_t{1} << 30;
+    constexpr int           kGenerations = 64; // 64 * 2^30 pages, 32x INT_MAX
+    Simulation sim(64, std::make_unique<LRUAlgorithm>(), tlbConfig());
+    unsigned long first = 0;
+    try {
+        for (int g = 0; g < kGenerations; ++g) {
+            const auto id = static_cast<unsigned char>(1 + g % 4);
+            sim.addProcess(id, kChurnPages, PageTableKind::Radix);
+            for (int i = 0; i < 1024; ++i) {
+                sim.handleMemoryAccess(MemoryAccessEvent((1 << 29) + bench::localityPage(i, 256, kHotPages),
+                                                         (i & 3) == 0, id));
+            }
+            const unsigned long faults = sim.processStats(id).pageFaults;
+            sim.removeProcess(id);
+            if (g == 0) first = faults;
+            if (faults != first) {
+                std::cout << "  -> generation " << g << " faults " << faults << ", first " << first << "!\n";
+                return false;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << "  -> process churn failed: " << e.what() << "\n";
+        return false;
+    }
+    std::cout << "--- churn: " << kGenerations << " processes of 2^30 pages, " << first
+              << " faults each ---\n";
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    const int frames = 4096;
+    bool ok = true;
+
+    for (int processes : {4, 32, 200}) {
+        std::cout << "--- " << processes << " processes, " << kSlice << "-access slices ---\n";
+
+        Simulation tagged(frames, std::make_unique<LRUAlgorithm>(), tlbConfig());
+        for (int id = 0; id < processes; ++id) tagged.addProcess(static_cast<unsigned char>(id), kPagesPerProcess);
+        const double tt = bench::timeSeconds([&] {
+            for (std::uint64_t i = 0; i < N; ++i) tagged.handleMemoryAccess(accessAt(i, processes));
+        });
+        const auto st = tagged.stats();
+        bench::report("ASID-tagged hit=" + std::to_string(int(st.tlbHitRate * 100)) + "%", N, tt);
+
+        // Flush on switch: one outside address space holding every process's
+        // pages at its own offset.
+        Simulation flushing(frames, std::make_unique<LRUAlgorithm>(), tlbConfig());
+        Process all(0, static_cast<unsigned int>(processes * kPagesPerProcess));
+        int current = -1;
+        const double tf = bench::timeSeconds([&] {
+            for (std::uint64_t i = 0; i < N; ++i) {
+                const MemoryAccessEvent ev = accessAt(i, processes);
+                if (ev.processId() != current) {
+                    current = ev.processId();
+                    flushing.setCurrentProcess(&all); // clears the TLB
+                }
+                flushing.handleMemoryAccess(
+                    MemoryAccessEvent(ev.pageId() + current * kPagesPerProcess, ev.write()));
+            }
+        });
+        const auto sf = flushing.stats();
+        bench::report("flush on switch hit=" + std::to_string(int(sf.tlbHitRate * 100)) + "%", N, tf);
+
+        if (st.pageFaults != sf.pageFaults) {
+            std::cout << "  -> page faults differ (" << st.pageFaults << " vs " << sf.pageFaults << ")!\n";
+            ok = false;
+        }
+    }
+    ok = checkChurn() && ok;
+    return ok ? 0 : 1;
+}
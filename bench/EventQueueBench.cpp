@@ -0,0 +1,154 @@
+/**
+ * @file EventQueueBench.cpp
+ * @brief Events/sec of the DES queue for random and monotonic (trace-like) schedules.
+ *
+ * Compares the legacy AddEvent(new Event) path with the pooled schedule()
+ * path on both backends, and checks that every run is strictly ordered by
+ * (time, insertion order), that a callable whose copy throws leaves the
+ * queue unchanged, and that extreme times (far beyond the calendar's window
+ * range) still run in order while NaN and infinite times are rejected.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "BenchUtil.h"
+#include "des/Event.h"
+#include "des/EventQueue.h"
+
+namespace {
+
+/// Pseudo-random but reproducible event times in [0, 1e6); duplicates occur.
+double randomTime(std::uint64_t i) {
+    return double((i * 2654435761u) % 1000003u);
+}
+
+/// Trace-like times: t += 1 with a few out-of-order stragglers.
+double monotonicTime(std::uint64_t i) {
+    return (i % 64 == 63) ? double(i) - 10.5 : double(i);
+}
+
+struct OrderCheck {
+    double        lastTime{-1e300};
+    std::uint64_t lastSeq{0};
+    bool          ok{true};
+
+    void seen(double t, std::uint64_t seq) {
+        if (t < lastTime || (t == lastTime && seq < lastSeq)) ok = false;
+        lastTime = t;
+        lastSeq  = seq;
+    }
+};
+
+bool runSchedule(const std::string& label, EventQueue q, std::uint64_t n,
+                 double (*timeOf)(std::uint64_t)) {
+    OrderCheck check;
+    const double t = bench::timeSeconds([&] {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const double at = timeOf(i);
+            q.schedule(at, [&check, at, i]() { check.seen(at, i); });
+        }
+        q.run();
+    });
+    bench::report(label, n, t, "events");
+    if (!check.ok) std::cout << "  -> events executed out of order!\n";
+    return check.ok;
+}
+
+/// Callable whose copy constructor throws; scheduling it by lvalue must schedule nothing.
+struct ThrowingCopy {
+    int* runs;
+    ThrowingCopy(int* r) : runs(r) {}
+    ThrowingCopy(const ThrowingCopy&) { throw std::runtime_error("copy"); }
+    ThrowingCopy(ThrowingCopy&&) noexcept = default;
+    void operator()() const { ++*runs; }
+};
+
+bool checkThrowingSchedule(const std::string& label, EventQueue q) {
+    int good = 0, bad = 0, threw = 0;
+    OrderCheck check;
+    const ThrowingCopy thrower(&bad);
+    for (std::uint64_t i = 0; i < 5000; ++i) {
+        try {
+            q.schedule(randomTime(i), thrower);
+        } catch (const std::runtime_error&) {
+            ++threw;
+        }
+        const double at = randomTime(i);
+        q.schedule(at, [&good, &check, at, i]() { ++good; check.seen(at, i); });
+    }
+    const bool sizeOk = q.size() == 5000;
+    q.run();
+    if (threw != 5000 || bad != 0 || good != 5000 || !sizeOk || !check.ok) {
+        std::cout << "  -> " << label << ": throwing copies were not rolled back cleanly!\n";
+        return false;
+    }
+    return true;
+}
+
+bool checkExtremeTimes(const std::string& label, EventQueue q) {
+    using L = std::numeric_limits<double>;
+    const double times[] = {5.0, L::max(), -L::max(), 1e300, -1e300, 0x1p63, -0x1p63, 1e-300,
+                            -0.0, 4e18, -4e18, L::max(), 7.5, 1e19};
+    OrderCheck check;
+    check.lastTime = -L::max();
+    int ran = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (std::uint64_t i = 0; i < std::size(times); ++i) {
+            const double at = times[i];
+            const std::uint64_t seq = round * std::size(times) + i;
+            q.schedule(at, [&ran, &check, at, seq]() { ++ran; check.seen(at, seq); });
+        }
+    }
+    int rejected = 0;
+    for (const double bad : {L::quiet_NaN(), L::infinity(), -L::infinity()}) {
+        try {
+            q.schedule(bad, [&ran]() { ++ran; });
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    q.run();
+    if (ran != int(3 * std::size(times)) || rejected != 3 || !check.ok) {
+        std::cout << "  -> " << label << ": extreme event times mishandled!\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    using B = EventQueue::Backend;
+    bool ok = true;
+
+    std::cout << "--- EventQueue, random times (" << N << " events) ---\n";
+    {
+        std::uint64_t sum = 0;
+        EventQueue q;
+        const double t = bench::timeSeconds([&] {
+            for (std::uint64_t i = 0; i < N; ++i) {
+                q.AddEvent(new Event([&sum, i]() { sum += i; }, randomTime(i)));
+            }
+            q.run();
+        });
+        bench::report("AddEvent(new Event) + run", N, t, "events");
+        bench::doNotOptimize(sum);
+    }
+    ok &= runSchedule("schedule(), binary heap", EventQueue(), N, randomTime);
+    ok &= runSchedule("schedule(), calendar", EventQueue(B::Calendar, 64.0, 1 << 14), N, randomTime);
+
+    std::cout << "--- EventQueue, monotonic times (" << N << " events) ---\n";
+    ok &= runSchedule("schedule(), binary heap", EventQueue(), N, monotonicTime);
+    ok &= runSchedule("schedule(), calendar", EventQueue(B::Calendar, 1.0, 1024), N, monotonicTime);
+
+    ok &= checkThrowingSchedule("binary heap", EventQueue());
+    ok &= checkThrowingSchedule("calendar", EventQueue(B::Calendar, 64.0, 1 << 10));
+    ok &= checkExtremeTimes("binary heap", EventQueue());
+    ok &= checkExtremeTimes("calendar", EventQueue(B::Calendar, 1e-3, 64));
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file LRUBench.cpp
+ * @brief LRU throughput for 4 .. 4M frames, checked against the map-based reference.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "ReferenceAlgorithms.h"
+#include "core/algorithms/LRUAlgorithm.h"
+
+namespace {
+
+/// Largest frame count for which the O(frames) reference is still replayed.
+constexpr int kMaxReferenceFrames = 1024;
+
+double replay(bench::AlgoDriver& drv, std::uint64_t n, int pages, int hot) {
+    return bench::timeSeconds([&] {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            drv.access(bench::localityPage(i, pages, hot), (i & 3) == 0);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t minAccesses = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    bool ok = true;
+
+    std::cout << "--- LRU (pages = 2 x frames, hot set = frames) ---\n";
+    for (int frames = 4; frames <= 4 * 1024 * 1024; frames *= 4) {
+        const int pages = 2 * frames;
+        const std::uint64_t n = std::max<std::uint64_t>(minAccesses, 4ull * frames);
+        const bool withReference = frames <= kMaxReferenceFrames;
+
+        LRUAlgorithm lru;
+        bench::AlgoDriver drv(lru, frames, pages, withReference);
+        const double t = replay(drv, n, pages, frames);
+        bench::report("LRUAlgorithm frames=" + std::to_string(frames), n, t);
+
+        if (withReference) {
+            reference::LRU ref;
+            bench::AlgoDriver refDrv(ref, frames, pages, true);
+            const double tr = replay(refDrv, n, pages, frames);
+            bench::report("  reference (map scan)", n, tr);
+            if (refDrv.victims() != drv.victims()) {
+                std::cout << "  -> victim sequence differs from reference!\n";
+                ok = false;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file LockstepBench.cpp
+ * @brief Six algorithms over one text trace: six passes vs one lockstep pass.
+ *
+ * Writes a 4-process text trace, then replays it through FIFO, LRU, NRU,
+ * NFU, NFU without aging and Second Chance (a) with one read-and-parse pass
+ * per algorithm, (b) with one lockstep pass on one thread and (c) with one
+ * lockstep pass and a worker per algorithm. All three must give the same
+ * statistics. The parse-only line is the cost (a) pays six times and the
+ * lockstep passes pay once; how much of the total that is depends on how
+ * expensive the simulations themselves are.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "TraceLoader.h"
+#include "sweep/Lockstep.h"
+#include "sweep/Sweep.h"
+
+namespace {
+
+const char* const kFile = "LockstepBench.trace";
+const std::vector<std::string> kAlgorithms{"fifo", "lru", "nru", "nfu", "nfu-noaging", "second-chance"};
+
+void writeTrace(std::uint64_t n) {
+    std::ofstream out(kFile);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        out << 1 + (i >> 10) % 4 << ':' << bench::localityPage(i, 1 << 14, 1 << 9)
+            << ((i & 3) == 0 ? " W\n" : " R\n");
+    }
+}
+
+std::unique_ptr<Simulation> makeSim(const std::string& algorithm) {
+    return std::make_unique<Simulation>(1024, makePagingAlgorithm(algorithm), 64);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    writeTrace(N);
+    bool ok = true;
+
+    const double tp = bench::timeSeconds([&] {
+        auto source = openTrace(kFile);
+        std::vector<MemoryAccessEvent> chunk;
+        while (source->next(chunk, 4096) > 0) chunk.clear();
+    });
+    bench::report("parse only", N, tp);
+
+    std::vector<Simulation::Stats> separate;
+    const double ts = bench::timeSeconds([&] {
+        for (const auto& a : kAlgorithms) {
+            LockstepRunner single;
+            single.add(a, makeSim(a));
+            auto source = openTrace(kFile);
+            single.run(*source);
+            separate.push_back(single.simulation(0).stats());
+        }
+    });
+    bench::report("6 passes (parse per algorithm)", N * kAlgorithms.size(), ts);
+
+    for (unsigned threads : {1u, unsigned(kAlgorithms.size())}) {
+        LockstepRunner runner;
+        for (const auto& a : kAlgorithms) runner.add(a, makeSim(a));
+        const double t = bench::timeSeconds([&] {
+            auto source = openTrace(kFile);
+            runner.run(*source, 4096, threads);
+        });
+        bench::report("1 lockstep pass, threads=" + std::to_string(threads), N * kAlgorithms.size(), t);
+        for (std::size_t i = 0; i < runner.size(); ++i) {
+            const auto s = runner.simulation(i).stats();
+            if (s.pageFaults != separate[i].pageFaults || s.tlbHits != separate[i].tlbHits
+                || s.avgAccessTimeUs != separate[i].avgAccessTimeUs) {
+                std::cout << "  -> " << runner.name(i) << " differs from its separate pass!\n";
+                ok = false;
+            }
+        }
+        if (threads == 1) runner.writeTable(std::cout);
+    }
+    std::remove(kFile);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file LoggingBench.cpp
+ * @brief Accesses/sec of Simulation::handleMemoryAccess with and without a logger.
+ *
+ * Also checks that BinaryEventLog ignores records after close() and that a
+ * failing write (to /dev/full, where available) surfaces as an exception
+ * from close() instead of being lost or blocking the producer.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "BenchUtil.h"
+#include "Simulation.h"
+#include "log/BinaryEventLog.h"
+#include "core/algorithms/FIFOAlgorithm.h"
+
+namespace {
+
+enum class Mode { Off, TextLogger, BinaryLog };
+
+/// Replay a looping page pattern slightly larger than memory (many faults).
+double run(std::uint64_t accesses, Mode mode, std::uint64_t& bytesLogged) {
+    const int NUM_FRAMES = 64;
+    const int NUM_PAGES  = 96;
+    Simulation sim(NUM_FRAMES, std::make_unique<FIFOAlgorithm>(), 16);
+    Process p(1, NUM_PAGES);
+    sim.setCurrentProcess(&p);
+    std::unique_ptr<BinaryEventLog> binLog;
+    if (mode == Mode::TextLogger) {
+        sim.setLogger([&bytesLogged](const std::string& line) { bytesLogged += line.size(); });
+    } else if (mode == Mode::BinaryLog) {
+        binLog = std::make_unique<BinaryEventLog>("LoggingBench.pslog");
+        sim.setLogSink(binLog.get());
+    }
+    return bench::timeSeconds([&] {
+        for (std::uint64_t i = 0; i < accesses; ++i) {
+            sim.handleMemoryAccess({static_cast<int>(i % NUM_PAGES), (i & 7) == 0});
+        }
+        if (binLog) binLog->close();
+    });
+}
+
+/// @return True if records after close() are ignored and write errors reach close().
+bool checkClose() {
+    bool ok = true;
+    {
+        BinaryEventLog log("LoggingBench.pslog", 4);
+        for (int i = 0; i < 1000; ++i) log.record(LogRecord{std::uint64_t(i), i, i % 16});
+        log.close();
+        for (int i = 0; i < 100; ++i) log.record(LogRecord{}); // used to spin once the ring filled
+        log.close();
+        const std::uint64_t read = readBinaryEventLog("LoggingBench.pslog", [](const LogRecord&) {});
+        if (read != 1000 || log.recordsWritten() != 1000) {
+            std::cout << "  -> " << read << " records on disk, " << log.recordsWritten() << " counted (1000 expected)!\n";
+            ok = false;
+        }
+    }
+    if (std::FILE* probe = std::fopen("/dev/full", "wb")) {
+        std::fclose(probe);
+        BinaryEventLog log("/dev/full", 4);
+        for (int i = 0; i < 100000; ++i) log.record(LogRecord{std::uint64_t(i)});
+        bool threw = false;
+        try {
+            log.close();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        log.record(LogRecord{});
+        if (!threw) {
+            std::cout << "  -> write errors on /dev/full were not reported by close()!\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    std::uint64_t bytes = 0;
+
+    std::cout << "--- Logging overhead (" << N << " accesses) ---\n";
+    bench::report("logger off", N, run(N, Mode::Off, bytes));
+    bench::report("logger on (discarding sink)", N, run(N, Mode::TextLogger, bytes));
+    bench::report("binary event log", N, run(N, Mode::BinaryLog, bytes));
+    const bool ok = checkClose();
+    std::remove("LoggingBench.pslog");
+    bench::doNotOptimize(bytes);
+    return ok ? 0 : 1;
+}
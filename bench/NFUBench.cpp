@@ -0,0 +1,55 @@
+/**
+ * @file NFUBench.cpp
+ * @brief NFU aging throughput per kernel (scalar / SSE2 / AVX2), checked against the reference.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "ReferenceAlgorithms.h"
+#include "core/algorithms/NFUAlgorithm.h"
+
+namespace {
+
+double replay(bench::AlgoDriver& drv, std::uint64_t n, int pages, int hot) {
+    return bench::timeSeconds([&] {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            drv.access(bench::localityPage(i, pages, hot), (i & 3) == 0);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t maxAccesses = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    const nfu::Kernel kernels[] = {nfu::Kernel::Scalar, nfu::Kernel::SSE2, nfu::Kernel::AVX2};
+    bool ok = true;
+
+    std::cout << "--- NFU aging (pages = 2 x frames, hot set = frames) ---\n";
+    for (int frames = 16; frames <= 16384; frames *= 4) {
+        const int pages = 2 * frames;
+        // Every eviction ages all frames: keep the total work bounded.
+        const std::uint64_t n = std::min<std::uint64_t>(maxAccesses, 1'000'000'000ull / frames);
+
+        reference::NFU ref;
+        bench::AlgoDriver refDrv(ref, frames, pages, true);
+        const double tr = replay(refDrv, n, pages, frames);
+        bench::report("reference (map) frames=" + std::to_string(frames), n, tr);
+
+        for (nfu::Kernel k : kernels) {
+            NFUAlgorithm nfuAlgo(k);
+            bench::AlgoDriver drv(nfuAlgo, frames, pages, true);
+            const double t = replay(drv, n, pages, frames);
+            bench::report(std::string("  NFUAlgorithm ") + nfuAlgo.kernelName(), n, t);
+            if (drv.victims() != refDrv.victims()) {
+                std::cout << "  -> victim sequence differs from reference!\n";
+                ok = false;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
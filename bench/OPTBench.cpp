@@ -0,0 +1,178 @@
+/**
+ * @file OPTBench.cpp
+ * @brief Optimal replacement: index build, side-file reuse and the lower bound.
+ *
+ * Checks OPTAlgorithm's victims against the forward-scanning reference on a
+ * short stream, then writes a 4-process binary trace and times building the
+ * next-use index (backward pass) against mapping it from the side file.
+ * Finally replays the trace through OPT and every built-in algorithm; OPT
+ * must have the fewest faults. For an address trace of a process whose heap
+ * is backed by 2 MiB pages, the index built from that address space must
+ * equal the index of the page IDs the simulation sees, and its side file
+ * must not be mixed up with one built for plain 4 KiB pages.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "ReferenceAlgorithms.h"
+#include "Simulation.h"
+#include "SimulationRegistry.h"
+#include "TraceLoader.h"
+#include "analysis/NextUseIndex.h"
+#include "core/algorithms/OPTAlgorithm.h"
+#include "trace/BinaryTrace.h"
+
+namespace {
+
+const char* const kFile = "OPTBench.bin";
+
+std::vector<MemoryAccessEvent> generate(std::uint64_t n) {
+    std::vector<MemoryAccessEvent> events;
+    events.reserve(n);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        events.emplace_back(bench::localityPage(i, 1 << 14, 1 << 10), (i & 3) == 0,
+                            static_cast<unsigned char>(1 + (i >> 10) % 4));
+    }
+    return events;
+}
+
+bool checkVictims() {
+    constexpr int kFrames = 64, kPages = 512;
+    std::vector<int> pages;
+    std::vector<MemoryAccessEvent> events;
+    for (std::uint64_t i = 0; i < 20'000; ++i) {
+        pages.push_back(bench::localityPage(i, kPages, 96));
+        events.emplace_back(pages.back(), false);
+    }
+    const NextUseIndex index = NextUseIndex::build(events);
+    OPTAlgorithm opt(index);
+    reference::OPT ref(pages);
+    bench::AlgoDriver drv(opt, kFrames, kPages, true), refDrv(ref, kFrames, kPages, true);
+    for (std::size_t i = 0; i < pages.size(); ++i) {
+        drv.access(pages[i], false);
+        refDrv.access(pages[i], false);
+    }
+    std::cout << "OPT faults " << drv.faults() << " (reference " << refDrv.faults() << ")\n";
+    if (drv.victims() != refDrv.victims()) {
+        std::cout << "  -> victim sequence differs from reference!\n";
+        return false;
+    }
+    return true;
+}
+
+/// Index of an address trace over 1 MiB of code (4 KiB pages) and a 64 MiB heap of 2 MiB pages.
+bool checkHugePages(std::uint64_t n) {
+    constexpr std::uint64_t kCodeBase = 0x400000, kHeapBase = 0x7f0000000000, kHeapBytes = 64 << 20;
+    std::vector<MemoryAccessEvent> events;
+    events.reserve(n);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        const std::uint64_t a = (i & 7) == 0
+            ? kCodeBase + std::uint64_t(bench::localityPage(i, 1 << 14, 1 << 10)) * 64
+            : kHeapBase + std::uint64_t(bench::localityPage(i, 1 << 20, 1 << 17)) * 64;
+        events.push_back(MemoryAccessEvent::atAddress(a, (i & 3) == 0, 1));
+    }
+    std::vector<AddressSpace> spaces(2);
+    spaces[1].mapHuge(kHeapBase, kHeapBytes, PageSize::Huge2M);
+
+    bool ok = true;
+    {
+        BinaryTraceWriter writer(kFile);
+        writer.add(events);
+    }
+    std::remove(NextUseIndex::defaultSidePath(kFile).c_str());
+    NextUseIndex::loadOrBuild(kFile); // side file for plain 4 KiB pages
+    const NextUseIndex index = NextUseIndex::loadOrBuild(kFile, 4096, {}, spaces);
+    const NextUseIndex again = NextUseIndex::loadOrBuild(kFile, 4096, {}, spaces);
+    const NextUseIndex plain = NextUseIndex::build(events);
+    if (index.mapped() || !again.mapped()) {
+        std::cout << "  -> side file of another address-space layout was reused!\n";
+        ok = false;
+    }
+    // Reference: the page IDs the simulated process hands out, indexed as page-ID accesses.
+    AddressSpace space = spaces[1];
+    std::vector<MemoryAccessEvent> pages;
+    pages.reserve(n);
+    for (const auto& ev : events) pages.emplace_back(space.translate(ev.address()), ev.write(), ev.processId());
+    const NextUseIndex expected = NextUseIndex::build(pages);
+    bool differs = false;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        if (index.nextUse(i) != expected.nextUse(i) || again.nextUse(i) != expected.nextUse(i)) {
+            std::cout << "  -> huge-page index differs from the simulation's pages at access " << i << "!\n";
+            ok = false;
+            break;
+        }
+        differs |= plain.nextUse(i) != expected.nextUse(i);
+    }
+    if (!differs) {
+        std::cout << "  -> huge mappings did not change the index!\n";
+        ok = false;
+    }
+
+    std::remove(NextUseIndex::defaultSidePath(kFile).c_str());
+    std::remove(kFile);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    bool ok = checkVictims();
+
+    const auto events = generate(N);
+    {
+        BinaryTraceWriter writer(kFile);
+        for (const auto& ev : events) writer.add(ev);
+    }
+    std::remove(NextUseIndex::defaultSidePath(kFile).c_str());
+
+    NextUseIndex index;
+    const double tb = bench::timeSeconds([&] { index = NextUseIndex::loadOrBuild(kFile); });
+    bench::report("build index + write side file", N, tb);
+    const double tm = bench::timeSeconds([&] { index = NextUseIndex::loadOrBuild(kFile); });
+    bench::report("map side file", N, tm);
+    if (!index.mapped() || index.size() != N) {
+        std::cout << "  -> side file was not reused!\n";
+        ok = false;
+    }
+    const NextUseIndex inMemory = NextUseIndex::build(events);
+    for (std::uint64_t i = 0; i < N && ok; ++i) {
+        if (index.nextUse(i) != inMemory.nextUse(i)) {
+            std::cout << "  -> mapped index differs at access " << i << "!\n";
+            ok = false;
+        }
+    }
+
+    const auto setUp = [](auto& sim) {
+        for (unsigned char id = 1; id <= 4; ++id) sim.addProcess(id, 1 << 14);
+    };
+    auto opt = makeOPTSimulation(index, 1024, TLBConfig{64});
+    setUp(*opt);
+    const double to = bench::timeSeconds([&] { opt->runBatch(events); });
+    bench::report("opt", N, to);
+    const unsigned long optFaults = opt->stats().pageFaults;
+    std::cout << "  faults " << optFaults << "\n";
+    for (const auto& name : pagingAlgorithmNames()) {
+        auto sim = makeStaticSimulation(name, 1024, TLBConfig{64});
+        setUp(*sim);
+        sim->runBatch(events);
+        const unsigned long faults = sim->stats().pageFaults;
+        std::cout << "  " << name << " faults " << faults << "\n";
+        if (faults < optFaults) {
+            std::cout << "  -> " << name << " beats OPT!\n";
+            ok = false;
+        }
+    }
+
+    std::remove(NextUseIndex::defaultSidePath(kFile).c_str());
+    std::remove(kFile);
+    ok = checkHugePages(N / 4) && ok;
+    return ok ? 0 : 1;
+}
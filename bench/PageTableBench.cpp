@@ -0,0 +1,89 @@
+/**
+ * @file PageTableBench.cpp
+ * @brief Sparse address spaces: dense page tables vs. 4-level radix tables.
+ *
+ * Each process has a 4 GiB address space (2^20 pages) but only touches three
+ * small regions (code, heap, stack), as real processes do. The dense variant
+ * allocates one entry per virtual page; the radix variant allocates nodes for
+ * the touched regions only and pays for the extra walk levels on TLB misses.
+ * Both must see the same page faults, since the layout only changes the walk.
+ *
+ * A third run gives every process the largest radix table (2^36 pages) and
+ * moves the upper regions to the top of the int page-ID range. The paging
+ * algorithm knows pages by frame, so its state ("policy=") must be the same
+ * in all three runs; so must the faults, since only the page numbers moved.
+ */
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "Simulation.h"
+#include "core/algorithms/LRUAlgorithm.h"
+
+namespace {
+
+constexpr std::uint64_t kPagesPerProcess = std::uint64_t{1} << 20;
+constexpr int           kRegionPages     = 4096;
+constexpr int           kTopRegion       = INT_MAX - kRegionPages + 1; ///< Highest region of the 2^36-page runs.
+constexpr int           kProcesses       = 16;
+constexpr int           kSlice           = 64; ///< Accesses per time slice.
+
+MemoryAccessEvent accessAt(std::uint64_t i, bool huge) {
+    static constexpr int kRegionBase[]     = {0, 1 << 19, (1 << 20) - kRegionPages};
+    static constexpr int kHugeRegionBase[] = {0, 1 << 30, kTopRegion};
+    const auto pid    = static_cast<unsigned char>(bench::localityPage(i / kSlice, kProcesses, kProcesses));
+    const int  region = static_cast<int>((i >> 4) % 3);
+    const int  page   = (huge ? kHugeRegionBase : kRegionBase)[region]
+                      + bench::localityPage(i, kRegionPages, kRegionPages / 16);
+    return MemoryAccessEvent(page, (i & 3) == 0, pid);
+}
+
+Simulation::Stats run(PageTableKind kind, std::uint64_t pages, std::uint64_t n, const char* label) {
+    Simulation sim(8192, std::make_unique<LRUAlgorithm>(), TLBConfig{64, 4, TLBReplacement::LRU});
+    for (int id = 0; id < kProcesses; ++id) {
+        sim.addProcess(static_cast<unsigned char>(id), pages, kind);
+    }
+    const bool huge = pages > kPagesPerProcess;
+    const double t = bench::timeSeconds([&] {
+        for (std::uint64_t i = 0; i < n; ++i) sim.handleMemoryAccess(accessAt(i, huge));
+    });
+    const Simulation::Stats s = sim.stats();
+    bench::report(std::string(label) + " tables=" + std::to_string(s.pageTableBytes >> 10) + " KiB"
+                  + " policy=" + std::to_string(s.algorithmBytes >> 10) + " KiB"
+                  + " avg=" + std::to_string(s.avgAccessTimeUs), n, t);
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+
+    std::cout << "--- " << kProcesses << " processes, 3 x " << kRegionPages
+              << "-page regions in 2^20 pages each ---\n";
+    const Simulation::Stats dense = run(PageTableKind::Dense, kPagesPerProcess, N, "dense");
+    const Simulation::Stats radix = run(PageTableKind::Radix, kPagesPerProcess, N, "radix");
+    const Simulation::Stats max   = run(PageTableKind::Radix, RadixPageTable::kMaxPages, N, "radix 2^36");
+    std::cout << "  walk levels per miss: dense "
+              << double(dense.pageWalkLevels) / double(dense.tlbMisses) << ", radix "
+              << double(radix.pageWalkLevels) / double(radix.tlbMisses) << "\n";
+
+    bool ok = true;
+    for (const Simulation::Stats* s : {&radix, &max}) {
+        if (s->pageFaults != dense.pageFaults || s->tlbMisses != dense.tlbMisses) {
+            std::cout << "  -> page faults or TLB misses differ (" << dense.pageFaults << " vs "
+                      << s->pageFaults << ")!\n";
+            ok = false;
+        }
+        if (s->algorithmBytes != dense.algorithmBytes) {
+            std::cout << "  -> policy state depends on the address space (" << dense.algorithmBytes
+                      << " vs " << s->algorithmBytes << " bytes)!\n";
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
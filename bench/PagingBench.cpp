@@ -0,0 +1,245 @@
+/**
+ * @file PagingBench.cpp
+ * @brief Benchmark suite: every algorithm x TLB size x frame count x workload,
+ *        with JSON export and regression check against a baseline.
+ *
+ * Usage: PagingBench [options]
+ * - --accesses n    Accesses per run (default 100000).
+ * - --repeats n     Runs per configuration; the median is reported (default 5).
+ * - --filter s      Only configurations whose name contains s.
+ * - --json file     Write the results as JSON (use as a later baseline).
+ * - --baseline file Compare with a JSON file written by --json.
+ * - --threshold f   Allowed slowdown against the baseline (default 0.10 = 10%).
+ * Exit status 1 if a configuration is slower than the baseline by more than
+ * the threshold or allocates more per access.
+ *
+ * Configurations are named workload/algorithm/tlbN/framesN. Each run builds
+ * a fresh statically bound simulation (see SimulationRegistry.h) with one
+ * process and replays the workload with runBatch; only the replay is timed.
+ * Allocations are counted by replacing the global operator new in this
+ * executable.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "SimulationRegistry.h"
+
+namespace {
+
+std::atomic<std::uint64_t> gAllocations{0};
+
+} // namespace
+
+void* operator new(std::size_t bytes) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(bytes ? bytes : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr int kPages = 1 << 14; ///< Page-table size of the benchmark process.
+
+/// A synthetic access pattern; page(i) is the page of access i.
+struct Workload {
+    const char* name;
+    int (*page)(std::uint64_t i);
+};
+
+std::uint64_t mix(std::uint64_t x) {
+    x = (x + 1) * 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 31; x *= 0xBF58476D1CE4E5B9ULL; x ^= x >> 29;
+    return x;
+}
+
+const Workload kWorkloads[] = {
+    {"locality", [](std::uint64_t i) { return bench::localityPage(i, kPages, 1024); }},
+    {"scan",     [](std::uint64_t i) { return static_cast<int>(i % kPages); }},
+    {"loop",     [](std::uint64_t i) { return static_cast<int>(i % 768); }},
+    {"random",   [](std::uint64_t i) { return static_cast<int>(mix(i) % kPages); }},
+};
+
+const int kTlbSizes[] = {0, 16, 64};
+const int kFrameCounts[] = {64, 1024};
+
+struct Result {
+    std::string   name;
+    std::string   workload;
+    std::string   algorithm;
+    int           tlb{0};
+    int           frames{0};
+    double        nsPerAccess{0};
+    double        allocsPerAccess{0};
+    unsigned long pageFaults{0};
+};
+
+struct BaselineEntry {
+    double nsPerAccess{0};
+    double allocsPerAccess{0};
+};
+
+double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    const std::size_t n = v.size();
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+Result measure(const Workload& w, const std::string& algorithm, int tlb, int frames,
+               const std::vector<MemoryAccessEvent>& events, int repeats) {
+    Result r{std::string(w.name) + "/" + algorithm + "/tlb" + std::to_string(tlb) + "/frames"
+                 + std::to_string(frames),
+             w.name, algorithm, tlb, frames};
+    std::vector<double> seconds;
+    for (int k = 0; k < repeats; ++k) {
+        auto sim = makeStaticSimulation(algorithm, frames, TLBConfig{static_cast<unsigned int>(tlb)});
+        sim->addProcess(1, kPages);
+        const std::uint64_t before = gAllocations.load(std::memory_order_relaxed);
+        seconds.push_back(bench::timeSeconds([&] { sim->runBatch(events); }));
+        const std::uint64_t allocs = gAllocations.load(std::memory_order_relaxed) - before;
+        if (k == 0) {
+            r.allocsPerAccess = double(allocs) / double(events.size());
+            r.pageFaults      = sim->stats().pageFaults;
+        }
+    }
+    r.nsPerAccess = median(seconds) * 1e9 / double(events.size());
+    return r;
+}
+
+void writeJson(const std::string& path, const std::vector<Result>& results,
+               std::uint64_t accesses, int repeats) {
+    std::ofstream os(path);
+    if (!os) throw std::runtime_error("Cannot create " + path);
+    os << std::setprecision(6) << "{\"accesses\": " << accesses << ", \"repeats\": " << repeats
+       << ", \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        // One object per line; readBaseline relies on it.
+        os << "  {\"name\": \"" << r.name << "\", \"workload\": \"" << r.workload
+           << "\", \"algorithm\": \"" << r.algorithm << "\", \"tlb\": " << r.tlb
+           << ", \"frames\": " << r.frames << ", \"accesses_per_sec\": " << 1e9 / r.nsPerAccess
+           << ", \"ns_per_access\": " << r.nsPerAccess << ", \"allocs_per_access\": "
+           << r.allocsPerAccess << ", \"page_faults\": " << r.pageFaults
+           << (i + 1 < results.size() ? "},\n" : "}\n");
+    }
+    os << "]}\n";
+}
+
+/** @return Value of "key": in @p line, as text up to the next ',' '"' or '}'. */
+std::string field(const std::string& line, const std::string& key) {
+    const std::string tag = "\"" + key + "\": ";
+    std::size_t pos = line.find(tag);
+    if (pos == std::string::npos) return {};
+    pos += tag.size();
+    if (line[pos] == '"') ++pos;
+    return line.substr(pos, line.find_first_of(",\"}", pos) - pos);
+}
+
+std::map<std::string, BaselineEntry> readBaseline(const std::string& path) {
+    std::ifstream is(path);
+    if (!is) throw std::runtime_error("Cannot open baseline " + path);
+    std::map<std::string, BaselineEntry> baseline;
+    for (std::string line; std::getline(is, line);) {
+        const std::string name = field(line, "name");
+        const std::string ns   = field(line, "ns_per_access");
+        if (name.empty() || ns.empty()) continue;
+        const std::string allocs = field(line, "allocs_per_access");
+        baseline[name] = BaselineEntry{std::stod(ns), allocs.empty() ? 0.0 : std::stod(allocs)};
+    }
+    return baseline;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t N = 100'000;
+    int           repeats = 5;
+    double        threshold = 0.10;
+    std::string   filter, jsonPath, baselinePath;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--accesses" && hasValue)       N = std::stoull(argv[++i]);
+            else if (arg == "--repeats" && hasValue)   repeats = std::max(1, std::stoi(argv[++i]));
+            else if (arg == "--filter" && hasValue)    filter = argv[++i];
+            else if (arg == "--json" && hasValue)      jsonPath = argv[++i];
+            else if (arg == "--baseline" && hasValue)  baselinePath = argv[++i];
+            else if (arg == "--threshold" && hasValue) threshold = std::stod(argv[++i]);
+            else throw std::invalid_argument("unexpected argument '" + arg + "'");
+        }
+        if (N == 0) throw std::invalid_argument("--accesses must be positive");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n"
+                  << "Usage: " << argv[0] << " [--accesses n] [--repeats n] [--filter s]\n"
+                  << "       [--json file] [--baseline file] [--threshold f]\n";
+        return 2;
+    }
+
+    try {
+        const auto baseline = baselinePath.empty() ? std::map<std::string, BaselineEntry>{}
+                                                   : readBaseline(baselinePath);
+        std::vector<Result> results;
+        int regressions = 0;
+
+        std::cout << std::left << std::setw(40) << "configuration" << std::right << std::setw(12)
+                  << "ns/access" << std::setw(14) << "accesses/s" << std::setw(14) << "allocs/access"
+                  << (baseline.empty() ? "" : "  vs baseline") << "\n";
+        for (const auto& w : kWorkloads) {
+            std::vector<MemoryAccessEvent> events;
+            events.reserve(N);
+            for (std::uint64_t i = 0; i < N; ++i) events.emplace_back(w.page(i), (i & 3) == 0, 1);
+
+            for (const auto& algorithm : pagingAlgorithmNames()) {
+                for (int tlb : kTlbSizes) {
+                    for (int frames : kFrameCounts) {
+                        const std::string name = std::string(w.name) + "/" + algorithm + "/tlb"
+                                               + std::to_string(tlb) + "/frames" + std::to_string(frames);
+                        if (name.find(filter) == std::string::npos) continue;
+                        const Result r = measure(w, algorithm, tlb, frames, events, repeats);
+                        std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed
+                                  << std::setprecision(2) << std::setw(12) << r.nsPerAccess
+                                  << std::setprecision(0) << std::setw(14) << 1e9 / r.nsPerAccess
+                                  << std::setprecision(4) << std::setw(14) << r.allocsPerAccess;
+                        const auto it = baseline.find(r.name);
+                        if (it != baseline.end()) {
+                            const double change = r.nsPerAccess / it->second.nsPerAccess - 1.0;
+                            const bool slower = change > threshold;
+                            const bool allocs = r.allocsPerAccess > it->second.allocsPerAccess + 1e-3;
+                            std::cout << std::setprecision(1) << std::showpos << std::setw(10)
+                                      << change * 100.0 << "%" << std::noshowpos
+                                      << (slower ? "  SLOWER" : "") << (allocs ? "  MORE ALLOCATIONS" : "");
+                            if (slower || allocs) ++regressions;
+                        }
+                        std::cout << "\n";
+                        results.push_back(r);
+                    }
+                }
+            }
+        }
+
+        if (!jsonPath.empty()) writeJson(jsonPath, results, N, repeats);
+        if (!baseline.empty()) {
+            std::cout << regressions << " of " << results.size() << " configurations regressed (threshold "
+                      << std::setprecision(0) << threshold * 100.0 << "%)\n";
+        }
+        return regressions ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+}
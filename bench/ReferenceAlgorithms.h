@@ -0,0 +1,193 @@
+/**
+ * @file ReferenceAlgorithms.h
+ * @brief Straightforward map-based replacement policies used as references.
+ *
+ * These are the original hash-map implementations of the optimized policies
+ * in src/core/algorithms. The benchmarks replay the same access stream
+ * through both and require an identical victim sequence.
+ */
+#ifndef BENCH_REFERENCEALGORITHMS_H
+#define BENCH_REFERENCEALGORITHMS_H
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/PagingAlgorithm.h"
+
+namespace reference {
+
+/** @brief LRU: linear scan for the smallest last-use counter. */
+class LRU : public PagingAlgorithm {
+public:
+    void memoryAccess(int pageId) override {
+        ++accessCounter;
+        auto it = table.find(pageId);
+        if (it != table.end()) it->second.lastUse = accessCounter;
+    }
+    int selectVictimPage() override {
+        if (table.empty()) throw std::logic_error("LRU: empty table");
+        long oldest = std::numeric_limits<long>::max();
+        int victimFrame = -1, victimPage = -1;
+        for (auto& kv : table) {
+            if (kv.second.lastUse < oldest) {
+                oldest = kv.second.lastUse;
+                victimFrame = kv.second.frameIndex;
+                victimPage = kv.first;
+            }
+        }
+        if (victimPage != -1) table.erase(victimPage);
+        return victimFrame;
+    }
+    void pageLoaded(int pageId, int frameIndex) override {
+        ++accessCounter;
+        table[pageId] = Info{frameIndex, accessCounter};
+    }
+
+private:
+    long accessCounter{0};
+    struct Info { int frameIndex; long lastUse; };
+    std::unordered_map<int, Info> table;
+};
+
+/**
+ * @brief NFU with aging: scan all pages, age them, evict the smallest age.
+ * @details The original iterated an unordered_map, so ties were broken in
+ *          unspecified hash order. This reference keeps the same aging but
+ *          iterates in frame order (first minimum wins), which is the
+ *          tie-break NFUAlgorithm defines.
+ */
+class NFU : public PagingAlgorithm {
+public:
+    void memoryAccess(int pageId) override {
+        auto it = frameOf.find(pageId);
+        if (it != frameOf.end()) table[it->second].referenced = true;
+    }
+    int selectVictimPage() override {
+        if (table.empty()) throw std::logic_error("NFU(aging): empty table");
+        for (auto& kv : table) {
+            auto& inf = kv.second;
+            inf.age = static_cast<std::uint8_t>((inf.age >> 1) | (inf.referenced ? 0x80 : 0x00));
+            inf.referenced = false;
+        }
+        auto victim = table.begin();
+        for (auto it = table.begin(); it != table.end(); ++it) {
+            if (it->second.age < victim->second.age) victim = it;
+        }
+        const int victimFrame = victim->first;
+        frameOf.erase(victim->second.pageId);
+        table.erase(victim);
+        return victimFrame;
+    }
+    void pageLoaded(int pageId, int frameIndex) override {
+        table[frameIndex] = Info{pageId, 0u, true};
+        frameOf[pageId] = frameIndex;
+    }
+
+private:
+    struct Info { int pageId; std::uint8_t age; bool referenced; };
+    std::map<int, Info> table;               ///< frameIndex -> Info (ordered)
+    std::unordered_map<int, int> frameOf;    ///< pageId -> frameIndex
+};
+
+/**
+ * @brief NRU: build the four (R,D) class lists, pick randomly from the lowest.
+ * @details Same RNG use as the original; classes are listed in frame order
+ *          (the original used unspecified unordered_map order).
+ */
+class NRU : public PagingAlgorithm {
+public:
+    explicit NRU(std::uint32_t seed = 0xC0FFEE) : rng(seed) {}
+
+    void memoryAccess(int pageId) override {
+        ++accessCount;
+        auto it = frameOf.find(pageId);
+        if (it != frameOf.end()) table[it->second].referenced = true;
+        if (accessCount % resetPeriod == 0) {
+            for (auto& kv : table) kv.second.referenced = false;
+        }
+    }
+    void onWrite(int pageId) override {
+        auto it = frameOf.find(pageId);
+        if (it != frameOf.end()) table[it->second].dirty = true;
+    }
+    int selectVictimPage() override {
+        if (table.empty()) throw std::logic_error("NRU: empty table");
+        std::vector<int> c00, c01, c10, c11;
+        for (auto& kv : table) {
+            const auto& inf = kv.second;
+            if (!inf.referenced && !inf.dirty) c00.push_back(kv.first);
+            else if (!inf.referenced && inf.dirty) c01.push_back(kv.first);
+            else if (inf.referenced && !inf.dirty) c10.push_back(kv.first);
+            else c11.push_back(kv.first);
+        }
+        int victimFrame = pickRandom(c00);
+        if (victimFrame == -1) victimFrame = pickRandom(c01);
+        if (victimFrame == -1) victimFrame = pickRandom(c10);
+        if (victimFrame == -1) victimFrame = pickRandom(c11);
+
+        frameOf.erase(table[victimFrame].pageId);
+        table.erase(victimFrame);
+        for (auto& kv : table) kv.second.referenced = false;
+        return victimFrame;
+    }
+    void pageLoaded(int pageId, int frameIndex) override {
+        table[frameIndex] = Info{pageId, true, false};
+        frameOf[pageId] = frameIndex;
+    }
+
+private:
+    int pickRandom(const std::vector<int>& v) {
+        if (v.empty()) return -1;
+        std::uniform_int_distribution<> d(0, static_cast<int>(v.size()) - 1);
+        return v[d(rng)];
+    }
+
+    struct Info { int pageId; bool referenced; bool dirty; };
+    std::map<int, Info> table;             ///< frameIndex -> Info (ordered)
+    std::unordered_map<int, int> frameOf;  ///< pageId -> frameIndex
+    std::mt19937 rng;
+    int accessCount{0};
+    int resetPeriod{64};
+};
+
+/**
+ * @brief OPT: for every resident page, search the trace forward for its next use.
+ * @details O(frames x distance) per eviction; ties go to the lowest frame.
+ */
+class OPT : public PagingAlgorithm {
+public:
+    explicit OPT(std::vector<int> trace) : trace(std::move(trace)) {}
+
+    void memoryAccess(int /*pageId*/) override { ++pos; }
+    int selectVictimPage() override {
+        if (table.empty()) throw std::logic_error("OPT: empty table");
+        std::size_t furthest = 0;
+        int victimFrame = -1;
+        for (const auto& [frame, page] : table) {
+            std::size_t next = pos;
+            while (next < trace.size() && trace[next] != page) ++next;
+            if (victimFrame == -1 || next > furthest) {
+                furthest = next;
+                victimFrame = frame;
+            }
+        }
+        table.erase(victimFrame);
+        return victimFrame;
+    }
+    void pageLoaded(int pageId, int frameIndex) override { table[frameIndex] = pageId; }
+
+private:
+    std::vector<int>   trace;
+    std::size_t        pos{0};
+    std::map<int, int> table; ///< frameIndex -> pageId (ordered)
+};
+
+} // namespace reference
+
+#endif // BENCH_REFERENCEALGORITHMS_H
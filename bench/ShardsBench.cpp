@@ -0,0 +1,76 @@
+/**
+ * @file ShardsBench.cpp
+ * @brief Sampled (SHARDS) miss-ratio curves vs the exact stack-distance pass.
+ *
+ * Computes the exact LRU miss-ratio curve of a locality stream over 4M pages
+ * once, then estimates it with sample budgets of 1K .. 64K pages. Each run
+ * reports throughput, the final sampling rate, the mean and maximum absolute
+ * error over 48 memory sizes and how many exact points lie inside the
+ * reported error bound. The 8K budget must stay within 0.01 on average.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "analysis/Shards.h"
+#include "analysis/StackDistance.h"
+
+namespace {
+
+constexpr int kPages = 1 << 22;
+
+/// Two working sets: a hot one of 16K pages and a warm one of 512K pages.
+std::uint64_t pageAt(std::uint64_t i) {
+    const int p = bench::localityPage(i, kPages, 1 << 19);
+    return std::uint64_t((i & 1) ? p : p & ((1 << 14) - 1));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+    bool ok = true;
+
+    std::vector<std::uint64_t> sizes;
+    for (double f = 16; f <= kPages; f *= std::pow(2.0, 0.375)) sizes.push_back(std::uint64_t(f));
+
+    StackDistanceAnalyzer exact;
+    const double te = bench::timeSeconds([&] {
+        for (std::uint64_t i = 0; i < N; ++i) exact.access(pageAt(i));
+    });
+    bench::report("exact stack distance (" + std::to_string(exact.distinctPages()) + " pages)", N, te);
+    const std::vector<std::uint64_t> faults = exact.faultCurve(kPages);
+
+    for (std::size_t budget : {1024u, 8192u, 65536u}) {
+        ShardsAnalyzer shards(budget);
+        const double t = bench::timeSeconds([&] {
+            for (std::uint64_t i = 0; i < N; ++i) shards.access(pageAt(i));
+        });
+        const auto curve = shards.missRatioCurve(sizes);
+
+        double sum = 0, worst = 0;
+        std::size_t covered = 0;
+        for (const MissRatioPoint& p : curve) {
+            const double err = std::abs(p.missRatio - double(faults[p.frames]) / double(N));
+            sum += err;
+            worst = std::max(worst, err);
+            if (err <= p.errorBound) ++covered;
+        }
+        const double mae = sum / double(curve.size());
+        bench::report("SHARDS budget=" + std::to_string(budget), N, t);
+        std::cout << std::setprecision(4) << "  rate=" << shards.samplingRate() << " pages~" << std::llround(shards.estimatedPages())
+                  << " mae=" << mae << " max=" << worst << " within bound " << covered << "/"
+                  << curve.size() << "\n";
+        if (budget == 8192 && mae > 0.01) {
+            std::cout << "  -> sampled curve too far from the exact one!\n";
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file StackDistanceBench.cpp
+ * @brief One stack-distance pass vs one LRU replay per frame count.
+ *
+ * Computes the whole LRU fault curve of a locality stream in a single pass,
+ * then replays the stream through LRUAlgorithm for a sweep of frame counts
+ * and through Simulation with a fully associative LRU TLB. Every replayed
+ * fault and TLB miss count must equal the curve.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "Simulation.h"
+#include "analysis/StackDistance.h"
+#include "core/algorithms/LRUAlgorithm.h"
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    constexpr int kPages = 1 << 16;
+    constexpr int kHot   = 1 << 12;
+    bool ok = true;
+
+    std::cout << "--- " << kPages << " pages, hot set " << kHot << " ---\n";
+    StackDistanceAnalyzer sd;
+    const double tPass = bench::timeSeconds([&] {
+        for (std::uint64_t i = 0; i < N; ++i) sd.access(std::uint64_t(bench::localityPage(i, kPages, kHot)));
+    });
+    bench::report("stack distance (one pass)", N, tPass);
+    const std::vector<std::uint64_t> curve = sd.faultCurve(kPages);
+
+    std::vector<int> frameCounts;
+    for (int frames = 16; frames <= kPages; frames *= 4) frameCounts.push_back(frames);
+    double tSweep = 0;
+    for (int frames : frameCounts) {
+        LRUAlgorithm lru;
+        bench::AlgoDriver drv(lru, frames, kPages);
+        const double t = bench::timeSeconds([&] {
+            for (std::uint64_t i = 0; i < N; ++i) drv.access(bench::localityPage(i, kPages, kHot), false);
+        });
+        tSweep += t;
+        bench::report("  LRU replay frames=" + std::to_string(frames), N, t);
+        if (drv.faults() != curve[frames]) {
+            std::cout << "  -> " << drv.faults() << " faults, curve says " << curve[frames] << "!\n";
+            ok = false;
+        }
+    }
+    std::cout << "  one pass = " << tPass / (tSweep / double(frameCounts.size()))
+              << " replays; the curve covers all " << kPages << " frame counts\n";
+
+    // A fully associative LRU TLB of C <= frames entries misses exactly curve[C] times.
+    for (unsigned int capacity : {64u, 512u}) {
+        Simulation sim(kHot, std::make_unique<LRUAlgorithm>(), TLBConfig{capacity, 0, TLBReplacement::LRU});
+        sim.addProcess(1, kPages);
+        const double t = bench::timeSeconds([&] {
+            for (std::uint64_t i = 0; i < N; ++i) {
+                sim.handleMemoryAccess(MemoryAccessEvent(bench::localityPage(i, kPages, kHot), false, 1));
+            }
+        });
+        const Simulation::Stats s = sim.stats();
+        bench::report("  Simulation TLB=" + std::to_string(capacity), N, t);
+        if (s.tlbMisses != curve[capacity] || s.pageFaults != curve[kHot]) {
+            std::cout << "  -> " << s.tlbMisses << " TLB misses / " << s.pageFaults
+                      << " faults, curve says " << curve[capacity] << " / " << curve[kHot] << "!\n";
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file StaticDispatchBench.cpp
+ * @brief Virtual vs statically bound replacement policy, per algorithm.
+ *
+ * Replays the same single-process stream through Simulation (the algorithm
+ * behind a PagingAlgorithm pointer) and through the statically bound
+ * BasicSimulation specialization of the same algorithm (OPT included, over
+ * the stream's NextUseIndex). Two workloads:
+ * - "policy-bound": TLB off and the working set fits in memory, so every
+ *   access is a page-table hit that ends in the policy's memoryAccess (and
+ *   onWrite) hook.
+ * - "fault-heavy": locality over 1.5x the frames behind a 64-entry TLB, so
+ *   many accesses also go through selectVictimPage and pageLoaded.
+ * Reports the best of five interleaved runs of each path and the speedup;
+ * the two must produce identical statistics.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "Simulation.h"
+#include "SimulationRegistry.h"
+#include "analysis/NextUseIndex.h"
+#include "core/algorithms/OPTAlgorithm.h"
+
+namespace {
+
+constexpr int kFrames  = 1024;
+constexpr int kRepeats = 5;
+
+struct Workload {
+    const char* name;
+    int         pages;    ///< Pages of the process.
+    int         hotPages; ///< Locality set (see bench::localityPage).
+    TLBConfig   tlb;
+};
+
+bool sameStats(const SimulationStats& a, const SimulationStats& b) {
+    return a.accesses == b.accesses && a.tlbHits == b.tlbHits && a.l2TlbHits == b.l2TlbHits
+        && a.pageFaults == b.pageFaults && a.avgAccessTimeUs == b.avgAccessTimeUs;
+}
+
+/// Best-of-kRepeats time of both paths on @p events; false if their statistics differ.
+bool compare(const std::string& label, const std::vector<MemoryAccessEvent>& events, int pages,
+             const std::function<std::unique_ptr<Simulation>()>& makeVirtual,
+             const std::function<std::unique_ptr<SimulationRunner>()>& makeStatic,
+             double& speedup) {
+    double tv = 0, ts = 0;
+    SimulationStats sv, ss;
+    for (int r = 0; r < kRepeats; ++r) {
+        auto dynamic = makeVirtual();
+        dynamic->addProcess(1, pages);
+        const double t = bench::timeSeconds([&] { dynamic->runBatch(events); });
+        if (r == 0 || t < tv) tv = t;
+        sv = dynamic->stats();
+
+        auto bound = makeStatic();
+        bound->addProcess(1, pages);
+        const double u = bench::timeSeconds([&] { bound->runBatch(events); });
+        if (r == 0 || u < ts) ts = u;
+        ss = bound->stats();
+    }
+    speedup = tv / ts;
+    std::cout << "--- " << label << " ---\n";
+    bench::report("virtual", events.size(), tv);
+    bench::report("static speedup=" + std::to_string(speedup).substr(0, 4), events.size(), ts);
+    if (!sameStats(sv, ss)) {
+        std::cout << "  -> statistics differ between the two paths!\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    bool ok = true;
+
+    const Workload workloads[] = {
+        {"policy-bound", kFrames / 2, kFrames / 8, TLBConfig{0}},
+        {"fault-heavy", 1 << 14, kFrames + kFrames / 2, TLBConfig{64, 4, TLBReplacement::LRU}},
+    };
+    for (const Workload& w : workloads) {
+        std::cout << "=== " << w.name << " ===\n";
+        std::vector<MemoryAccessEvent> events;
+        events.reserve(N);
+        for (std::uint64_t i = 0; i < N; ++i) {
+            events.emplace_back(bench::localityPage(i, w.pages, w.hotPages), (i & 3) == 0,
+                                static_cast<unsigned char>(1));
+        }
+
+        double product = 1;
+        int    count   = 0;
+        for (const auto& name : pagingAlgorithmNames()) {
+            double speedup = 1;
+            ok &= compare(name, events, w.pages,
+                          [&] { return std::make_unique<Simulation>(kFrames, makePagingAlgorithm(name), w.tlb); },
+                          [&] { return makeStaticSimulation(name, kFrames, w.tlb); }, speedup);
+            product *= speedup;
+            ++count;
+        }
+        const NextUseIndex future = NextUseIndex::build(events);
+        double speedup = 1;
+        ok &= compare("opt", events, w.pages,
+                      [&] { return std::make_unique<Simulation>(kFrames, std::make_unique<OPTAlgorithm>(future), w.tlb); },
+                      [&] { return makeOPTSimulation(future, kFrames, w.tlb); }, speedup);
+        product *= speedup;
+        ++count;
+
+        std::cout << "geomean speedup (" << w.name << "): " << std::setprecision(3)
+                  << std::pow(product, 1.0 / count) << "\n";
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file SweepBench.cpp
+ * @brief Parameter-sweep scaling: one shared trace, 1 .. N worker threads.
+ *
+ * Decodes a synthetic 4-process trace once and runs the full grid of
+ * algorithms x frame counts x TLB sizes with increasing thread counts.
+ * Reports the wall time and speedup over one thread (meaningless beyond
+ * the machine's core count). Every thread count
+ * must produce the same statistics as the single-threaded run.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "sweep/Sweep.h"
+
+namespace {
+
+/// Locality stream of four interleaved processes, produced in chunks.
+class GeneratedSource : public TraceSource {
+public:
+    explicit GeneratedSource(std::uint64_t n) : n_(n) {}
+
+    std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) override {
+        std::size_t k = 0;
+        for (; k < maxCount && i_ < n_; ++k, ++i_) {
+            out.emplace_back(bench::localityPage(i_, 1 << 14, 1 << 10), (i_ & 3) == 0,
+                             static_cast<unsigned char>(1 + (i_ >> 12) % 4));
+        }
+        return k;
+    }
+
+private:
+    std::uint64_t n_;
+    std::uint64_t i_{0};
+};
+
+bool sameStats(const Simulation::Stats& a, const Simulation::Stats& b) {
+    return a.accesses == b.accesses && a.tlbHits == b.tlbHits && a.pageFaults == b.pageFaults
+        && a.avgAccessTimeUs == b.avgAccessTimeUs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    bool ok = true;
+
+    GeneratedSource source(N);
+    SharedTrace trace;
+    const double td = bench::timeSeconds([&] { trace = SharedTrace::decode(source); });
+    bench::report("decode once", N, td);
+
+    std::vector<TLBConfig> tlbs{TLBConfig{16, 0, TLBReplacement::FIFO}, TLBConfig{64, 4, TLBReplacement::LRU}};
+    const auto configs = sweepGrid(pagingAlgorithmNames(), {64, 256, 1024, 4096}, tlbs);
+    std::cout << "--- " << configs.size() << " runs of " << N << " accesses ---\n";
+
+    std::vector<SweepResult> reference;
+    double t1 = 0;
+    // Powers of two up to the core count, then the core count itself; at least
+    // up to 4 threads so the shared-trace path is exercised on small machines.
+    const unsigned hw = std::max(4u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < hw; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(hw);
+    for (unsigned threads : threadCounts) {
+        std::vector<SweepResult> results;
+        const double t = bench::timeSeconds([&] { results = runSweep(trace, configs, threads); });
+        if (threads == 1) {
+            reference = results;
+            t1 = t;
+        }
+        bench::report("threads=" + std::to_string(threads) + " speedup=" + std::to_string(t1 / t).substr(0, 4),
+                      N * configs.size(), t);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            if (!sameStats(results[i].stats, reference[i].stats)) {
+                std::cout << "  -> run " << i << " differs from the single-threaded sweep!\n";
+                ok = false;
+                break;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
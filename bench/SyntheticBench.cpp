@@ -0,0 +1,222 @@
+/**
+ * @file SyntheticBench.cpp
+ * @brief Synthetic workload generation and binary trace writing throughput.
+ *
+ * Times each generator, then writing a loop workload to a binary trace one
+ * access at a time and in batches. Checks that the same seed gives the same
+ * stream and another seed a different one, that both writer paths produce
+ * the same file and that it reads back unchanged, that a failing write
+ * makes close() throw, that the share of Zipf's most popular page matches
+ * 1 / H(pages, skew), and that specs with non-finite, fractional or
+ * out-of-range values are rejected naming the key.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "trace/BinaryTrace.h"
+#include "trace/Synthetic.h"
+
+namespace {
+
+const char* const kOne   = "SyntheticBench.one.bin";
+const char* const kBatch = "SyntheticBench.batch.bin";
+
+std::vector<MemoryAccessEvent> drain(TraceSource& source) {
+    std::vector<MemoryAccessEvent> all;
+    while (source.next(all, 1 << 16) > 0) {}
+    return all;
+}
+
+bool same(const std::vector<MemoryAccessEvent>& a, const std::vector<MemoryAccessEvent>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].pageId() != b[i].pageId() || a[i].write() != b[i].write()
+            || a[i].processId() != b[i].processId()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<char> readFile(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+    bool ok = true;
+
+    SyntheticOptions opt;
+    opt.accesses   = N;
+    opt.seed       = 42;
+    opt.writeRatio = 0.25;
+
+    const auto generate = [&](const std::string& label, TraceSource& source) {
+        std::vector<MemoryAccessEvent> chunk;
+        chunk.reserve(1 << 16);
+        std::uint64_t checksum = 0;
+        const double t = bench::timeSeconds([&] {
+            while (source.next(chunk, 1 << 16) > 0) {
+                for (const auto& ev : chunk) checksum += static_cast<std::uint64_t>(ev.pageId()) + ev.write();
+                chunk.clear();
+            }
+        });
+        bench::doNotOptimize(checksum);
+        bench::report(label, N, t);
+    };
+    {
+        ZipfSource zipf(1 << 20, 0.99, opt);
+        generate("zipf skew=0.99", zipf);
+        ScanSource scan(1 << 20, 8, opt);
+        generate("scan run=8", scan);
+        LoopSource loop = LoopSource::justLargerThan(4096, opt);
+        generate("loop 4097 pages", loop);
+        PhaseSource phase(1 << 20, 4096, 1'000'000, opt);
+        generate("phase set=4096", phase);
+    }
+
+    // Determinism.
+    {
+        SyntheticOptions small = opt;
+        small.accesses = 100'000;
+        auto a = makeSyntheticTrace("zipf:pages=65536,skew=0.8,accesses=1e5,seed=42,writes=0.25");
+        ZipfSource b(65536, 0.8, small);
+        small.seed = 43;
+        ZipfSource c(65536, 0.8, small);
+        const auto sa = drain(*a), sb = drain(b), sc = drain(c);
+        if (!same(sa, sb)) {
+            std::cout << "  -> same seed, different stream!\n";
+            ok = false;
+        }
+        if (same(sa, sc)) {
+            std::cout << "  -> different seeds, same stream!\n";
+            ok = false;
+        }
+    }
+
+    // Spec validation: each bad value must throw naming its key.
+    {
+        const struct { const char* spec; const char* key; } bad[] = {
+            {"loop:pages=0", "pages"},           {"loop:pages=1e10", "pages"},
+            {"loop:pages=-5", "pages"},          {"loop:pages=2.5", "pages"},
+            {"loop:pages=nan", "pages"},         {"loop:accesses=0", "accesses"},
+            {"loop:accesses=1e30", "accesses"},  {"loop:accesses=inf", "accesses"},
+            {"loop:pid=256", "pid"},             {"loop:pid=-1", "pid"},
+            {"loop:seed=-1", "seed"},            {"loop:seed=0.5", "seed"},
+            {"scan:run=0", "run"},               {"phase:pages=64,set=65", "set"},
+            {"phase:phase=0", "phase"},          {"zipf:skew=inf", "skew"},
+            {"loop:writes=nan", "writes"},
+        };
+        for (const auto& b : bad) {
+            std::string message;
+            try {
+                makeSyntheticTrace(b.spec);
+            } catch (const std::invalid_argument& e) {
+                message = e.what();
+            }
+            if (message.find(std::string("'") + b.key + "'") == std::string::npos) {
+                std::cout << "  -> '" << b.spec << "' not rejected for '" << b.key << "': " << message << "\n";
+                ok = false;
+            }
+        }
+        auto edge = makeSyntheticTrace("loop:pages=1,accesses=1,pid=255,seed=0");
+        const auto events = drain(*edge);
+        if (events.size() != 1 || events[0].pageId() != 0 || events[0].processId() != 255) {
+            std::cout << "  -> edge spec produced the wrong stream!\n";
+            ok = false;
+        }
+    }
+
+    // Zipf head: P(page 0) = 1 / H(n, s).
+    {
+        constexpr int kPages = 1000;
+        constexpr double kSkew = 1.2;
+        SyntheticOptions z = opt;
+        z.accesses = 2'000'000;
+        ZipfSource zipf(kPages, kSkew, z);
+        std::uint64_t hits = 0;
+        for (const auto& ev : drain(zipf)) hits += ev.pageId() == 0;
+        double harmonic = 0;
+        for (int k = 1; k <= kPages; ++k) harmonic += std::pow(k, -kSkew);
+        const double expected = 1.0 / harmonic, measured = double(hits) / double(z.accesses);
+        std::cout << std::defaultfloat << std::setprecision(4) << "zipf P(page 0) = " << measured << " (expected " << expected << ")\n";
+        if (std::abs(measured - expected) > 0.01 * expected + 0.001) {
+            std::cout << "  -> Zipf head share is off!\n";
+            ok = false;
+        }
+    }
+
+    // Binary writing: per access vs batch.
+    {
+        LoopSource loop(4097, opt);
+        const auto events = drain(loop);
+        const double t1 = bench::timeSeconds([&] {
+            BinaryTraceWriter writer(kOne);
+            for (const auto& ev : events) writer.add(ev);
+            writer.close();
+        });
+        bench::report("write binary, per access", N, t1);
+        const double tb = bench::timeSeconds([&] {
+            BinaryTraceWriter writer(kBatch);
+            writer.add(events);
+            writer.close();
+        });
+        bench::report("write binary, batch", N, tb);
+        if (readFile(kOne) != readFile(kBatch)) {
+            std::cout << "  -> batch and per-access files differ!\n";
+            ok = false;
+        }
+        BinaryTraceReader reader(kBatch);
+        if (!same(drain(reader), events)) {
+            std::cout << "  -> binary trace does not read back!\n";
+            ok = false;
+        }
+
+        LoopSource again(4097, opt);
+        const double tg = bench::timeSeconds([&] {
+            BinaryTraceWriter writer(kBatch);
+            std::vector<MemoryAccessEvent> chunk;
+            chunk.reserve(1 << 16);
+            while (again.next(chunk, 1 << 16) > 0) {
+                writer.add(chunk);
+                chunk.clear();
+            }
+            writer.close();
+        });
+        bench::report("generate + write binary", N, tg);
+
+        // A short write (no space left) must surface from close(), not a truncated file.
+        if (std::FILE* probe = std::fopen("/dev/full", "wb")) {
+            std::fclose(probe);
+            BinaryTraceWriter full("/dev/full");
+            full.add(events);
+            bool threw = false;
+            try {
+                full.close();
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            if (!threw) {
+                std::cout << "  -> write errors on /dev/full were not reported by close()!\n";
+                ok = false;
+            }
+        }
+    }
+    std::remove(kOne);
+    std::remove(kBatch);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file TLBBench.cpp
+ * @brief Set-associative TLB vs. the former deque-based FIFO TLB.
+ *
+ * Replays the simulation's TLB protocol (lookup, fill on miss, occasional
+ * invalidation by frame) over a skewed page stream. The fully associative
+ * FIFO configuration must produce exactly the lookups of the deque TLB; the
+ * other shapes report their hit rate alongside the throughput. The last
+ * section drives an L1/L2 hierarchy through the MMU with both fill policies;
+ * an exclusive hierarchy must never hold a page in both levels.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "AlgoDriver.h"
+#include "BenchUtil.h"
+#include "core/CoreStructs.h"
+
+namespace {
+
+/// The deque TLB as it was before the set-associative rewrite.
+struct DequeTLB {
+    std::deque<TLBEntry> entries;
+    unsigned int         capacity;
+
+    explicit DequeTLB(unsigned int cap) : capacity(cap) {}
+
+    int lookup(int page) const {
+        for (const auto& e : entries) if (e.page_index == page) return e.frame_index;
+        return -1;
+    }
+    void addOrUpdate(int page, int frame) {
+        if (capacity == 0) return;
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->page_index == page) { entries.erase(it); break; }
+        }
+        if (entries.size() == capacity) entries.pop_front();
+        entries.push_back(TLBEntry{page, frame, 0});
+    }
+    void deleteEntryByFrame(int frame) {
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->frame_index == frame) { entries.erase(it); break; }
+        }
+    }
+};
+
+/// Simulation-like TLB protocol; frame == page, every 64th access invalidates a frame.
+template <class Tlb>
+std::uint64_t replay(Tlb& tlb, std::uint64_t n, int pages, std::vector<int>* trace) {
+    std::uint64_t hits = 0;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        const int page  = bench::localityPage(i, pages, pages / 16);
+        const int frame = tlb.lookup(page);
+        if (trace) trace->push_back(frame);
+        if (frame >= 0) ++hits;
+        else            tlb.addOrUpdate(page, page);
+        if ((i & 63) == 63) tlb.deleteEntryByFrame(bench::localityPage(i * 7, pages, pages / 16));
+    }
+    return hits;
+}
+
+/// MMU protocol: L1, then L2, then a page walk that fills the hierarchy.
+struct HierarchyResult {
+    std::uint64_t l1Hits{0}, l2Hits{0};
+    bool          exclusiveViolated{false};
+};
+
+HierarchyResult replayHierarchy(MMU& mmu, std::uint64_t n, int pages) {
+    HierarchyResult r;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        const int page = bench::localityPage(i, pages, pages / 16);
+        if (mmu.tlb.lookup(page) != -1)     ++r.l1Hits;
+        else if (mmu.lookupSTLB(page) != -1) ++r.l2Hits;
+        else                                  mmu.fill(page, page);
+        if ((i & 63) == 63) mmu.invalidateFrame(bench::localityPage(i * 7, pages, pages / 16));
+        if (mmu.stlbFill == TLBFill::Exclusive && (i & 4095) == 0) {
+            for (const TLBEntry& e : mmu.tlb.entries()) {
+                if (mmu.stlb.getPageForFrame(e.frame_index) == e.page_index) r.exclusiveViolated = true;
+            }
+        }
+    }
+    return r;
+}
+
+const char* name(TLBReplacement r) {
+    switch (r) {
+    case TLBReplacement::FIFO:   return "FIFO";
+    case TLBReplacement::LRU:    return "LRU";
+    case TLBReplacement::Random: return "Random";
+    case TLBReplacement::PLRU:   return "PLRU";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t N = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    const int pages = 1 << 16;
+    bool ok = true;
+
+    std::cout << "--- Fully associative FIFO vs. deque TLB ---\n";
+    for (unsigned int cap : {16u, 64u, 256u, 1024u}) {
+        std::vector<int> expected, actual;
+        const std::uint64_t n = N / 8;
+
+        DequeTLB ref(cap);
+        std::uint64_t refHits = 0;
+        const double tr = bench::timeSeconds([&] { refHits = replay(ref, n, pages, &expected); });
+        bench::report("deque TLB cap=" + std::to_string(cap), n, tr);
+
+        TLB tlb(cap);
+        std::uint64_t hits = 0;
+        const double tt = bench::timeSeconds([&] { hits = replay(tlb, n, pages, &actual); });
+        bench::report("  TLB (flat, full assoc.)", n, tt);
+
+        if (hits != refHits || actual != expected) {
+            std::cout << "  -> lookups differ from deque TLB!\n";
+            ok = false;
+        }
+    }
+
+    std::cout << "--- Set-associative shapes (1024 entries) ---\n";
+    const unsigned int cap = 1024;
+    for (unsigned int ways : {4u, 8u, 16u, cap}) {
+        for (TLBReplacement r : {TLBReplacement::FIFO, TLBReplacement::LRU,
+                                 TLBReplacement::Random, TLBReplacement::PLRU}) {
+            if (r == TLBReplacement::PLRU && ways > 64) continue;
+            TLB tlb(TLBConfig{cap, ways, r});
+            std::uint64_t hits = 0;
+            const double t = bench::timeSeconds([&] { hits = replay(tlb, N, pages, nullptr); });
+            const std::string shape = ways == cap ? "full" : std::to_string(ways) + "-way";
+            bench::report(shape + " " + name(r) + " hit=" + std::to_string(hits * 100 / N) + "%",
+                          N, t);
+        }
+    }
+
+    std::cout << "--- L1 (64, 4-way LRU) + L2 (1024, 8-way LRU) ---\n";
+    for (TLBFill fill : {TLBFill::Inclusive, TLBFill::Exclusive}) {
+        MMU mmu(TLBHierarchyConfig{{TLBConfig{64, 4, TLBReplacement::LRU}, 1.0},
+                                   {TLBConfig{1024, 8, TLBReplacement::LRU}, 7.0},
+                                   fill, {}});
+        HierarchyResult r;
+        const double t = bench::timeSeconds([&] { r = replayHierarchy(mmu, N, pages); });
+        const char* label = fill == TLBFill::Inclusive ? "inclusive" : "exclusive";
+        bench::report(std::string(label) + " L1=" + std::to_string(r.l1Hits * 100 / N) + "% L2="
+                      + std::to_string(r.l2Hits * 100 / N) + "%", N, t);
+        if (r.exclusiveViolated) {
+            std::cout << "  -> page held in both levels of an exclusive hierarchy!\n";
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,333 @@
+/**
+ * @file TraceParseBench.cpp
+ * @brief Trace reading throughput: istringstream vs. TextTraceParser vs. BinaryTraceReader.
+ *
+ * Also checks that corrupt or truncated binary traces of every version are
+ * rejected with std::runtime_error instead of being read past their blocks,
+ * and that a text trace with process IDs reads back the same after encoding
+ * it as binary version 2 and version 3, with out-of-range process IDs
+ * rejected by the text parser. Address accesses ("0x..." with and without
+ * "pid:") must parse to the generated addresses and survive version 3;
+ * malformed hex targets must be rejected.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "trace/BinaryTrace.h"
+#include "trace/TextTraceParser.h"
+
+namespace {
+
+const char* const kFile    = "TraceParseBench.trace";
+const char* const kBinFile = "TraceParseBench.pstrace";
+const char* const kBadFile = "TraceParseBench.bad.pstrace";
+const char* const kPidFile = "TraceParseBench.pid.trace";
+
+void writeTrace(std::uint64_t lines) {
+    std::ofstream out(kFile);
+    out << "# pageId [R|W]\n";
+    std::uint64_t x = 12345;
+    for (std::uint64_t i = 0; i < lines; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        out << ((x >> 33) % 100000) << ((x & 0x300) ? " R\n" : " W\n");
+    }
+}
+
+/// The parsing loop loadTrace used before TextTraceParser existed.
+std::uint64_t parseIstream(std::uint64_t& checksum) {
+    std::ifstream file(kFile);
+    std::string line;
+    std::uint64_t n = 0;
+    while (std::getline(file, line)) {
+        std::string trimmed = line;
+        trimmed.erase(0, trimmed.find_first_not_of(" \t\r\n"));
+        if (trimmed.empty() || trimmed[0] == '#') continue;
+        std::istringstream iss(trimmed);
+        int pageId; char rw = 'R';
+        iss >> pageId;
+        if (iss.good()) iss >> rw;
+        checksum += pageId + (rw == 'W');
+        ++n;
+    }
+    return n;
+}
+
+std::uint64_t drain(TraceSource& source, std::uint64_t& checksum) {
+    std::vector<MemoryAccessEvent> chunk;
+    chunk.reserve(4096);
+    std::uint64_t n = 0;
+    while (source.next(chunk, 4096) > 0) {
+        for (const auto& ev : chunk) checksum += ev.pageId() + ev.write();
+        n += chunk.size();
+        chunk.clear();
+    }
+    return n;
+}
+
+void putLE(std::vector<unsigned char>& out, std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<unsigned char>(v >> (8 * i)));
+}
+
+/// Binary trace of one block whose header claims @p count accesses in @p bytes bytes.
+void writeBlock(std::uint32_t version, std::uint32_t bytes, std::uint32_t count,
+                const std::vector<unsigned char>& payload, const char* path = kBadFile) {
+    std::vector<unsigned char> file{'P', 'S', 'T', 'R', 'A', 'C', 'E', '\0'};
+    putLE(file, version, 4);
+    putLE(file, 1 << 16, 4);
+    putLE(file, count, 8);
+    putLE(file, bytes, 4);
+    putLE(file, count, 4);
+    file.insert(file.end(), payload.begin(), payload.end());
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(file.data()),
+                                                static_cast<std::streamsize>(file.size()));
+}
+
+/// Version 2 payload of page-ID accesses: zigzag(delta) << 2 | P << 1 | W, then the process ID if P.
+std::vector<unsigned char> encodeV2(std::span<const MemoryAccessEvent> events) {
+    std::vector<unsigned char> out;
+    std::uint64_t prev = 0;
+    unsigned char pid  = 0;
+    for (const auto& ev : events) {
+        const auto target = static_cast<std::uint64_t>(static_cast<std::int64_t>(ev.pageId()));
+        const std::uint64_t delta  = target - prev;
+        const std::uint64_t zigzag = (delta << 1) ^ (0 - (delta >> 63));
+        const bool newPid = ev.processId() != pid;
+        // Deltas of int page IDs fit in 33 bits, so the varint value fits in 64.
+        std::uint64_t v = (zigzag << 2) | (newPid ? 2u : 0u) | (ev.write() ? 1u : 0u);
+        for (; v >= 0x80; v >>= 7) out.push_back(static_cast<unsigned char>(v | 0x80));
+        out.push_back(static_cast<unsigned char>(v));
+        if (newPid) out.push_back(ev.processId());
+        prev = target;
+        pid  = ev.processId();
+    }
+    return out;
+}
+
+std::vector<MemoryAccessEvent> readAll(TraceSource& source) {
+    std::vector<MemoryAccessEvent> all, chunk;
+    while (source.next(chunk, 4096) > 0) {
+        all.insert(all.end(), chunk.begin(), chunk.end());
+        chunk.clear();
+    }
+    return all;
+}
+
+bool sameEvents(const std::vector<MemoryAccessEvent>& a, const std::vector<MemoryAccessEvent>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].isAddress() != b[i].isAddress() || a[i].write() != b[i].write()
+            || a[i].processId() != b[i].processId()
+            || (a[i].isAddress() ? a[i].address() != b[i].address() : a[i].pageId() != b[i].pageId())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @return True if text -> binary v2 / v3 -> events reproduces the parsed text. */
+bool checkRoundTrip() {
+    // Valid lines with and without "pid:", including both ends of the pid
+    // range and negative page IDs; every 97th line has an out-of-range pid.
+    std::size_t valid = 0, invalid = 0;
+    {
+        std::ofstream out(kPidFile);
+        out << "# [pid:]pageId [R|W]\n";
+        std::uint64_t x = 777;
+        for (int i = 0; i < 20000; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            const long page = static_cast<long>((x >> 20) % 200000) - 1000;
+            const char* rw  = (x & 0x300) ? " R\n" : " W\n";
+            if (i % 97 == 0) {
+                out << ((x & 1) ? long(256 + (x >> 40) % 1000) : -1 - long((x >> 40) % 5)) << ':' << page << rw;
+                ++invalid;
+                continue;
+            }
+            switch ((x >> 50) % 4) {
+            case 0:  out << page << rw; break;
+            case 1:  out << (x >> 52) % 256 << ':' << page << rw; break;
+            case 2:  out << "255:" << page << rw; break;
+            default: out << "0:" << page << rw; break;
+            }
+            ++valid;
+        }
+    }
+    TextTraceParser text(kPidFile);
+    const std::vector<MemoryAccessEvent> events = readAll(text);
+    bool ok = true;
+    if (events.size() != valid || text.malformedLines() != invalid) {
+        std::cout << "  -> text parser kept " << events.size() << " of " << valid << " lines and rejected "
+                  << text.malformedLines() << " of " << invalid << " out-of-range pids!\n";
+        ok = false;
+    }
+
+    const std::vector<unsigned char> payload = encodeV2(events);
+    writeBlock(2, static_cast<std::uint32_t>(payload.size()), static_cast<std::uint32_t>(events.size()), payload);
+    {
+        BinaryTraceReader v2(kBadFile);
+        if (!sameEvents(events, readAll(v2))) {
+            std::cout << "  -> text and binary v2 events differ!\n";
+            ok = false;
+        }
+    }
+    {
+        BinaryTraceWriter writer(kBadFile);
+        writer.add(events);
+    }
+    {
+        BinaryTraceReader v3(kBadFile);
+        if (!sameEvents(events, readAll(v3))) {
+            std::cout << "  -> text and binary v3 events differ!\n";
+            ok = false;
+        }
+    }
+    std::remove(kPidFile);
+    std::remove(kBadFile);
+    return ok;
+}
+
+/** @return True if "0x" address lines parse as generated, survive binary v3, and bad hex is rejected. */
+bool checkAddressRoundTrip() {
+    const char* const badLines[] = {
+        "0x", "0x W", "7:0x", "0xZZ", "0xg00 W", "3:0x-10", "0x1ffffffffffffffff", "300:0x10",
+    };
+    std::vector<MemoryAccessEvent> expected;
+    {
+        std::ofstream out(kPidFile);
+        out << "# [pid:]0xaddress|pageId [R|W]\n";
+        std::uint64_t x = 4242;
+        for (int i = 0; i < 20000; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            const bool write = (x & 0x300) == 0;
+            const auto pid   = static_cast<unsigned char>((x >> 8) % 4 == 0 ? 0 : (x >> 16) % 256);
+            // Full 64-bit addresses, small ones near 0 and the occasional page ID.
+            const std::uint64_t address = (x >> 56) < 8 ? (x >> 44) : x ^ (x << 7);
+            if (i % 7 == 0) {
+                const int page = static_cast<int>((x >> 33) % 100000);
+                out << int(pid) << ':' << page << (write ? " W" : " R") << '\n';
+                expected.emplace_back(page, write, pid);
+            } else {
+                if (pid != 0 || (x & 0x400)) out << int(pid) << ':';
+                out << ((x & 0x800) ? "0X" : "0x") << std::hex << address << std::dec
+                    << (write ? ((x & 0x1000) ? " w" : " W") : " R") << '\n';
+                expected.push_back(MemoryAccessEvent::atAddress(address, write, pid));
+            }
+            if (i % 1000 == 0) out << badLines[(i / 1000) % std::size(badLines)] << '\n';
+        }
+    }
+    TextTraceParser text(kPidFile);
+    const std::vector<MemoryAccessEvent> events = readAll(text);
+    bool ok = true;
+    if (!sameEvents(expected, events)) {
+        std::cout << "  -> parsed address events differ from the generated ones!\n";
+        ok = false;
+    }
+    if (text.malformedLines() != 20) {
+        std::cout << "  -> " << text.malformedLines() << " of 20 malformed hex lines rejected!\n";
+        ok = false;
+    }
+    {
+        BinaryTraceWriter writer(kBadFile);
+        writer.add(events);
+    }
+    {
+        BinaryTraceReader v3(kBadFile);
+        if (!sameEvents(events, readAll(v3))) {
+            std::cout << "  -> text and binary v3 address events differ!\n";
+            ok = false;
+        }
+    }
+    std::remove(kPidFile);
+    std::remove(kBadFile);
+    return ok;
+}
+
+/** @return True if every corrupt file is rejected with std::runtime_error. */
+bool checkCorruptFiles() {
+    struct Case {
+        const char*                name;
+        std::uint32_t              bytes;
+        std::uint32_t              count;
+        std::vector<unsigned char> payload;
+    };
+    const std::vector<Case> cases{
+        {"count larger than payload", 1, 50'000'000, {0x80}},
+        {"accesses past payload", 2, 2, {0x80, 0x80}},
+        {"varint over 10 bytes", 12, 2, std::vector<unsigned char>(12, 0xff)},
+        {"truncated payload", 10, 5, {0x02, 0x04, 0x06}},
+    };
+    bool ok = true;
+    for (std::uint32_t version : {1u, 2u, 3u}) {
+        for (const auto& c : cases) {
+            writeBlock(version, c.bytes, c.count, c.payload);
+            bool rejected = false;
+            try {
+                BinaryTraceReader reader(kBadFile);
+                std::vector<MemoryAccessEvent> out;
+                while (reader.next(out, 4096) > 0) out.clear();
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+            if (!rejected) {
+                std::cout << "  -> v" << version << " " << c.name << " was not rejected!\n";
+                ok = false;
+            }
+        }
+    }
+    std::remove(kBadFile);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t LINES = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5'000'000;
+    writeTrace(LINES);
+    std::uint64_t bytes = 0;
+    { std::ifstream f(kFile, std::ios::binary | std::ios::ate); bytes = f.tellg(); }
+
+    {
+        TextTraceParser text(kFile);
+        BinaryTraceWriter writer(kBinFile);
+        std::vector<MemoryAccessEvent> chunk;
+        while (text.next(chunk, 4096) > 0) {
+            for (const auto& ev : chunk) writer.add(ev);
+            chunk.clear();
+        }
+    }
+    std::uint64_t binBytes = 0;
+    { std::ifstream f(kBinFile, std::ios::binary | std::ios::ate); binBytes = f.tellg(); }
+
+    std::uint64_t sumA = 0, sumB = 0, sumC = 0, nA = 0, nB = 0, nC = 0;
+    const double tA = bench::timeSeconds([&] { nA = parseIstream(sumA); });
+    const double tB = bench::timeSeconds([&] { TextTraceParser p(kFile); nB = drain(p, sumB); });
+    const double tC = bench::timeSeconds([&] { BinaryTraceReader r(kBinFile); nC = drain(r, sumC); });
+
+    std::cout << "--- Text trace parsing (" << LINES << " lines, " << bytes << " bytes) ---\n";
+    bench::reportThroughput("getline + istringstream", bytes, tA);
+    bench::reportThroughput("TextTraceParser (mmap + from_chars)", bytes, tB);
+    bench::report("TextTraceParser", nB, tB);
+    std::cout << "binary trace: " << binBytes << " bytes (" << double(bytes) / binBytes
+              << "x smaller than text)\n";
+    bench::reportThroughput("BinaryTraceReader (decoded text-equiv.)", bytes, tC);
+    bench::report("BinaryTraceReader", nC, tC);
+
+    bool ok = nA == nB && nB == nC && sumA == sumB && sumB == sumC;
+    if (!ok) std::cout << "MISMATCH between readers!\n";
+    ok = checkCorruptFiles() && ok;
+    ok = checkRoundTrip() && ok;
+    ok = checkAddressRoundTrip() && ok;
+
+    std::remove(kFile);
+    std::remove(kBinFile);
+    return ok ? 0 : 1;
+}
@@ -2,6 +2,8 @@
 #define SIMULATION_H
 
 #include <memory>
+#include <span>
+#include <type_traits>
 #include <vector>
 #include <functional>   ///< Logger callback
 #include <string>
@@ -9,16 +11,68 @@
 #include "core/CoreStructs.h"
 #include "core/PagingAlgorithm.h"
 #include "core/MemoryAccessEvent.h"
+#include "log/LogRecord.h"
+#include "log/LogSink.h"
+
+#ifndef PAGING_ENABLE_LOGGING
+#define PAGING_ENABLE_LOGGING 1 ///< Set to 0 to compile all step messages out.
+#endif
+
+/**
+ * @brief Aggregated simulation statistics.
+ */
+struct SimulationStats {
+    unsigned long accesses{0};        ///< Total memory accesses.
+    unsigned long tlbHits{0};         ///< TLB hits (any level).
+    unsigned long tlbMisses{0};       ///< TLB misses (all levels missed, page walk).
+    unsigned long l1TlbHits{0};       ///< L1 TLB hits.
+    unsigned long l1TlbMisses{0};     ///< L1 TLB misses.
+    unsigned long l2TlbHits{0};       ///< L2 TLB hits (0 without an L2).
+    unsigned long l2TlbMisses{0};     ///< L2 TLB misses (0 without an L2).
+    unsigned long pageFaults{0};      ///< Page faults.
+    unsigned long contextSwitches{0}; ///< Switches between table processes (totals only).
+    unsigned long pageWalkLevels{0};  ///< Page-table levels referenced by walks (dense: 1 per walk).
+    std::size_t   pageTableBytes{0};  ///< Page-table memory of the simulated processes.
+    std::size_t   algorithmBytes{0};  ///< Replacement-policy state (see PagingAlgorithm::footprintBytes).
+    unsigned long hugePageAccesses{0}; ///< Accesses to 2 MiB/1 GiB pages.
+    unsigned long hugePageFaults{0};  ///< Page faults on 2 MiB/1 GiB pages.
+    std::uint64_t tlbReachBytes{0};   ///< Memory covered by the L1 TLB entries now (incl. huge L1).
+    std::uint64_t stlbReachBytes{0};  ///< Memory covered by the L2 TLB entries now.
+    double        avgAccessTimeUs{0}; ///< Average time per access (microseconds).
+    double        tlbHitRate{0};      ///< TLB hit rate   in [0,1].
+    double        pageFaultRate{0};   ///< Page fault rate in [0,1].
+};
 
 /**
- * @class Simulation
+ * @class BasicSimulation
  * @brief Paging simulation engine.
  *
  * - Inject any replacement algorithm implementing @ref PagingAlgorithm.
  * - Keeps track of TLB hits/misses, page faults and average access time.
+ * - Runs either one externally owned process (@ref setCurrentProcess) or the
+ *   processes of its own table (@ref addProcess); accesses are routed by
+ *   their process ID and TLB entries are ASID-tagged, so switching between
+ *   table processes does not flush the TLB.
  * - Can forward step-by-step messages to a UI through a logger callback.
+ *   Messages are kept as raw @ref LogRecord values and only formatted when a
+ *   logger is installed; with no logger the hot path does no formatting or
+ *   allocation. Building with PAGING_ENABLE_LOGGING=0 removes them entirely.
+ *
+ * The replacement algorithm and the TLB model are template parameters.
+ * @ref Simulation (Algo = PagingAlgorithm) takes any algorithm at run time
+ * and calls it through virtual functions. A concrete Algo is held by value,
+ * so its hooks are called directly on every access. The member definitions
+ * are in Simulation.tpp, so other Algo types can be instantiated anywhere.
+ * Simulation itself is instantiated in Simulation.cpp. The built-in
+ * algorithms are explicitly instantiated one per file in src/static/ (e.g.
+ * src/static/LRUSimulation.cpp) and declared extern in SimulationRegistry.h;
+ * use SimulationRegistry.h to pick one by name.
+ *
+ * @tparam Algo PagingAlgorithm, or a concrete algorithm derived from it.
+ * @tparam Tlb  TLB model of every level (@ref TLB).
  */
-class Simulation {
+template <class Algo, class Tlb = TLB>
+class BasicSimulation {
 public:
     /**
      * @brief Callback type for one-line log messages.
@@ -30,21 +84,33 @@ public:
      * @brief Set or replace the external logger.
      * @param cb Callback to receive log lines (moved). If empty, messages are dropped.
      */
-    void setLogger(Logger cb) { logger_ = std::move(cb); }
+    void setLogger(Logger cb) {
+        logger_ = std::move(cb);
+        loggingActive_ = logger_ || logSink_;
+    }
 
+    /**
+     * @brief Attach a sink for raw step records (e.g. @ref BinaryEventLog).
+     * @param sink Non-owning pointer; nullptr detaches. Records are passed
+     *             unformatted, so no text is built for this sink.
+     */
+    void setLogSink(LogSink* sink) {
+        logSink_ = sink;
+        loggingActive_ = logger_ || logSink_;
+    }
+
+    /** @return True if messages are compiled in and a logger or sink is attached. */
+    bool loggingActive() const { return kLoggingCompiled && loggingActive_; }
+
+
+    /// Aggregated simulation statistics (shared by all instantiations).
+    using Stats = SimulationStats;
 
     /**
-     * @brief Aggregated simulation statistics.
+     * @brief How the replacement algorithm is held: owned through a pointer
+     *        for the abstract interface, by value for a concrete algorithm.
      */
-    struct Stats {
-        unsigned long accesses{0};        ///< Total memory accesses.
-        unsigned long tlbHits{0};         ///< TLB hits.
-        unsigned long tlbMisses{0};       ///< TLB misses.
-        unsigned long pageFaults{0};      ///< Page faults.
-        double        avgAccessTimeUs{0}; ///< Average time per access (microseconds).
-        double        tlbHitRate{0};      ///< TLB hit rate   in [0,1].
-        double        pageFaultRate{0};   ///< Page fault rate in [0,1].
-    };
+    using AlgoHandle = std::conditional_t<std::is_abstract_v<Algo>, std::unique_ptr<Algo>, Algo>;
 
     /**
      * @brief Construct the simulation.
@@ -52,8 +118,28 @@ public:
      * @param algo         Replacement algorithm (ownership transferred).
      * @param tlbCapacity  TLB capacity (number of entries).
      */
-    Simulation(int numFrames, std::unique_ptr<PagingAlgorithm> algo, int tlbCapacity);
-    ~Simulation() = default;
+    BasicSimulation(int numFrames, AlgoHandle algo, int tlbCapacity);
+
+    /**
+     * @brief Construct the simulation with a configurable TLB.
+     * @param numFrames  Number of physical frames.
+     * @param algo       Replacement algorithm (ownership transferred).
+     * @param tlbConfig  TLB capacity, associativity and replacement policy.
+     * @throws std::invalid_argument if the TLB shape is not supported.
+     */
+    BasicSimulation(int numFrames, AlgoHandle algo, const TLBConfig& tlbConfig);
+
+    /**
+     * @brief Construct the simulation with an L1/L2 TLB hierarchy.
+     * @details Every access is charged the L1 latency; an L1 miss additionally
+     *          pays the L2 latency when an L2 is configured.
+     * @param numFrames  Number of physical frames.
+     * @param algo       Replacement algorithm (ownership transferred).
+     * @param tlbConfig  Shape, policy and latency of each level plus the fill policy.
+     * @throws std::invalid_argument if a TLB shape is not supported.
+     */
+    BasicSimulation(int numFrames, AlgoHandle algo, const TLBHierarchyConfig& tlbConfig);
+    ~BasicSimulation() = default;
 
     /**
      * @brief Handles a single memory access event.
@@ -68,17 +154,32 @@ public:
      * 4.  **Page Hit**: If the page is in main memory, the access is simulated and the TLB is updated.
      *
      * The method also updates the relevant counters for the simulation statistics.
+     * Address accesses (@ref MemoryAccessEvent::atAddress) are first translated
+     * to a page ID with the issuing process's @ref AddressSpace; do not mix
+     * them with page-ID accesses in one process.
      *
-     * @param event The event containing the target data for the memory access (virtual page number and access type R/W).
+     * @param event The event containing the target data for the memory access (virtual page number or address and access type R/W).
      */
     void handleMemoryAccess(const MemoryAccessEvent& event);
 
+    /**
+     * @brief Handle a batch of accesses in order, without going through the EventQueue.
+     * @details Equivalent to calling @ref handleMemoryAccess for each element; meant for
+     *          plain traces where event timing is irrelevant (no per-access allocation).
+     * @param events Accesses to replay.
+     */
+    void runBatch(std::span<const MemoryAccessEvent> events);
+
     /**
      * @brief Handles a page fault by loading a page into a physical frame.
-     * @details Finds a free frame or evicts a victim page via the paging algorithm.
+     * @details Takes a frame from the free-frame list (O(1)) or, if memory is full,
+     * evicts a victim page via the paging algorithm. A huge page occupies
+     * AddressSpace::framesPerPage frames; victims are evicted until that many
+     * are free (they need not be contiguous).
      * It then loads the requested page and updates the page table and TLB.
      * @param requestedPageId The virtual page ID that caused the fault.
      * @param writeAccess     True if the fault was from a write operation.
+     * @throws std::logic_error if a huge page needs more frames than memory has.
      */
     void handlePageFault(int requestedPageId, bool writeAccess);
 
@@ -86,7 +187,82 @@ public:
      * @brief Set the current process (also clears the TLB).
      * @param process Non-owning pointer to the active process.
      */
-    void setCurrentProcess(Process* process) { mmu_.setCurrentProcess(process); }
+    void setCurrentProcess(Process* process) {
+        mmu_.setCurrentProcess(process);
+        bindProcess(process);
+    }
+
+    /**
+     * @brief Create a process in the simulation's process table.
+     * @details Accesses whose MemoryAccessEvent::processId() names a table
+     *          process run in that process. All table processes share the
+     *          physical frames and the paging algorithm, which knows every
+     *          resident page by its frame, so its state does not grow with
+     *          the size of the address spaces. Accesses with an ID that is not
+     *          in the table run in the current process. Do not mix table
+     *          processes with @ref setCurrentProcess on outside processes.
+     * @param id              Process ID, also used as the TLB ASID.
+     * @param numVirtualPages Size of the process's page table.
+     * @param kind            Page table layout; a radix table only allocates
+     *                        nodes for the regions the process touches (up
+     *                        to RadixPageTable::kMaxPages pages).
+     * @return The new process.
+     * @throws std::invalid_argument if @p id is already in use or a radix
+     *         table is larger than RadixPageTable::kMaxPages.
+     */
+    Process& addProcess(unsigned char id, std::uint64_t numVirtualPages,
+                        PageTableKind kind = PageTableKind::Dense);
+
+    /**
+     * @brief Release all frames of a table process and remove it. No-op if unknown.
+     * @details Its TLB entries are flushed so the ID can be reused; its
+     *          accesses remain part of @ref stats.
+     * @param id Process ID.
+     */
+    void removeProcess(unsigned char id);
+
+    /** @return Table process with ID @p id, or nullptr. */
+    Process* process(unsigned char id) const;
+
+    /**
+     * @brief Make a table process current without flushing the TLB (O(1)).
+     * @param id Process ID.
+     * @throws std::invalid_argument if there is no such table process.
+     */
+    void switchProcess(unsigned char id);
+
+    /**
+     * @brief Statistics of the accesses issued by one table process.
+     * @param id Process ID.
+     */
+    Stats processStats(unsigned char id) const;
+
+    /**
+     * @brief Release one frame back to the free list.
+     * @details Unmaps the page it holds from its owning process (page table,
+     *          TLB, paging algorithm via @ref PagingAlgorithm::pageUnloaded).
+     *          No-op for free frames.
+     * @param frameIndex Frame to release.
+     */
+    void releaseFrame(int frameIndex);
+
+    /**
+     * @brief Release all frames mapped by a process (e.g. on process exit).
+     * @param process Process whose present pages are unmapped.
+     */
+    void releaseProcessFrames(Process& process);
+
+    /**
+     * @brief Set the page-walk cost model.
+     * @details A TLB miss walks the current page table; every level above the
+     *          leaf that the walk references (up to 3 for radix tables, none for
+     *          dense tables) costs @p perLevel.
+     * @param perLevel Time per upper page-table level.
+     */
+    void setPageWalkLevelTime(double perLevel) { pageWalkLevelTime_ = perLevel; }
+
+    /** @return Number of frames currently on the free list. */
+    std::size_t freeFrameCount() const { return freeFrames_.size(); }
 
     /**
      * @brief Print statistics to std::cout (CLI demo helper).
@@ -106,7 +282,7 @@ public:
     /**
      * @brief Read-only view of the MMU (including the TLB).
      */
-    const MMU& mmuView() const { return mmu_; }
+    const BasicMMU<Tlb>& mmuView() const { return mmu_; }
 
     /**
      * @deprecated Use @ref mainMemoryView().
@@ -118,36 +294,131 @@ public:
      * @deprecated Use @ref mmuView().
      */
     [[deprecated("Use mmuView() instead")]]
-    MMU getMMU() const { return mmu_; }
+    BasicMMU<Tlb> getMMU() const { return mmu_; }
 
 private:
+    static constexpr bool kLoggingCompiled = PAGING_ENABLE_LOGGING != 0;
+
+    /// Per-process access counters (summed for @ref stats).
+    struct Counters {
+        unsigned long accesses{0};
+        unsigned long tlbHits{0};
+        unsigned long tlbMisses{0};
+        unsigned long l2TlbHits{0};
+        unsigned long l2TlbMisses{0};
+        unsigned long pageFaults{0};
+        unsigned long walkLevels{0};
+        unsigned long hugeAccesses{0};
+        unsigned long hugeFaults{0};
+        double        accessTime{0.0};
+    };
+
+    /// Slot of the process table, indexed by process ID.
+    struct ProcessSlot {
+        std::unique_ptr<Process> process;
+    };
+
+    static constexpr std::size_t kMaxProcesses = 256; ///< One per unsigned char process ID.
+
+    /**
+     * @brief Emit a step message if a logger or sink is installed.
+     * @details Only a flag test on the hot path; the record is built and
+     *          formatted out of line in @ref dispatchLog.
+     * @param kind  Message kind.
+     * @param page  Virtual page concerned.
+     * @param frame Physical frame concerned (-1 if none).
+     * @param aux   Kind-specific extra value (see @ref LogEventKind).
+     */
+    void log(LogEventKind kind, int page, int frame = -1, int aux = -1) {
+        if constexpr (kLoggingCompiled) {
+            if (loggingActive_) [[unlikely]] dispatchLog(kind, page, frame, aux);
+        }
+    }
+
+    /** @return The replacement algorithm; a concrete Algo is a member object, so calls bind statically. */
+    Algo& policy() {
+        if constexpr (std::is_abstract_v<Algo>) return *pagingAlgorithm_;
+        else                                    return pagingAlgorithm_;
+    }
+    const Algo& policy() const {
+        if constexpr (std::is_abstract_v<Algo>) return *pagingAlgorithm_;
+        else                                    return pagingAlgorithm_;
+    }
+
+    /** @brief Unmap the page in @p frameIndex of @p process and return the frame to the free list. */
+    void freeFrame(int frameIndex, Process& process);
+
+    /** @return Page ID of an address access in the process that issues it (-1 if none). */
+    int translateAddress(const MemoryAccessEvent& event);
+
     /**
-     * @brief Emit a log line if a logger is installed.
-     * @param msg Text to forward to the external logger.
+     * @brief Free frames for a huge page, evicting as needed, and reserve them.
+     * @return The frame that holds the mapping; the others are its tail frames.
      */
-    void log(const std::string& msg) { if (logger_) logger_(msg); }
+    int allocateHugeFrames(std::uint64_t count, int requestedPageId);
+
+    /** @brief Return the tail frames reserved with @p headFrame (if any) to the free list. */
+    void releaseTailFrames(int headFrame);
+
+    /** @return Bytes covered by the entries of @p tlb (of ASID @p asid, or all if -1). */
+    std::uint64_t reachBytes(const Tlb& tlb, int asid) const;
+
+    /** @brief Point the counters at @p process (after the MMU switched). */
+    void bindProcess(Process* process);
+
+    /** @brief Switch to table process @p id on behalf of an access and log it. */
+    void contextSwitch(unsigned char id);
+
+    /** @brief Turn counters into the public statistics record. */
+    static Stats makeStats(const Counters& c);
+    /** @return Page-table bytes of the table processes plus an outside current process. */
+    std::size_t pageTableBytes() const;
+    static void  addCounters(Counters& into, const Counters& c);
+
+    /** @brief Build the record for the current step and forward it to the sinks. */
+    void dispatchLog(LogEventKind kind, int page, int frame, int aux);
 
     std::vector<PageFrame>           mainMemory_;        ///< Physical memory frames.
-    std::unique_ptr<PagingAlgorithm> pagingAlgorithm_;   ///< Replacement policy.
-    MMU                              mmu_;               ///< MMU with a FIFO TLB.
+    std::vector<int>                 freeFrames_;        ///< Free frames (stack; lowest index on top initially).
+    AlgoHandle                       pagingAlgorithm_;   ///< Replacement policy.
+    BasicMMU<Tlb>                    mmu_;               ///< MMU with the TLB hierarchy.
+    std::vector<Process*>            frameOwner_;        ///< Frame -> process whose page it holds.
+    std::vector<std::vector<int>>    tailFrames_;        ///< Head frame of a huge page -> its other frames.
+    std::vector<ProcessSlot>         processes_;         ///< Process table (empty until addProcess).
+    double                           l1TlbTime_{TLB_HIT_TIME}; ///< Cost of an L1 TLB probe.
+    double                           l2TlbTime_{0.0};    ///< Cost of an L2 TLB probe.
+    double                           pageWalkLevelTime_{PAGE_WALK_LEVEL_TIME}; ///< Cost per upper page-table level.
 
-    // Counters / accumulation
-    unsigned long totalAccesses_{0};
-    unsigned long tlbHits_{0};
-    unsigned long tlbMisses_{0};
-    unsigned long pageFaults_{0};
-    double        totalAccessTime_{0.0};
+    // Counters: [0] = processes outside the table and removed processes,
+    // [1 + id] = table process id.
+    std::vector<Counters> counters_;
+    Counters*             cur_{nullptr};       ///< Counters of the current process.
+    unsigned long         contextSwitches_{0};
+    bool                  addressAccesses_{false}; ///< Any address access seen (enables the reach report).
 
     // Step counter for UI headers ("Schritt N").
     unsigned long stepCounter_{0};
+    bool          stepWrite_{false}; ///< Access type of the current step (for records).
 
     // Optional external logger injected by the UI.
-    Logger logger_;
+    Logger   logger_;
+    LogSink* logSink_{nullptr};      ///< Optional raw record sink (not owned).
+    bool     loggingActive_{false};  ///< Cached "logger_ or logSink_ set" for the hot path.
 
     // Time constants (arbitrary units; treated as microseconds).
     static constexpr double TLB_HIT_TIME       = 1.0;
     static constexpr double MEMORY_ACCESS_TIME = 100.0;
     static constexpr double PAGE_FAULT_TIME    = 10000.0;
+    /// Extra cost per page-table level above the leaf touched by a walk
+    /// (the leaf reference is part of MEMORY_ACCESS_TIME; dense tables have none).
+    static constexpr double PAGE_WALK_LEVEL_TIME = 20.0;
 };
 
+/// Run-time polymorphic simulation: any PagingAlgorithm, chosen at run time.
+using Simulation = BasicSimulation<PagingAlgorithm>;
+
+extern template class BasicSimulation<PagingAlgorithm>;
+
+#include "Simulation.tpp"
+
 #endif // SIMULATION_H
\ No newline at end of file
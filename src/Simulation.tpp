@@ -0,0 +1,538 @@
+/**
+ * @file Simulation.tpp
+ * @brief Member definitions of BasicSimulation, included at the end of Simulation.h.
+ *
+ * Kept in the header so that any algorithm or TLB type can be bound
+ * (BasicSimulation<OPTAlgorithm>, a custom Tlb, ...) and the compiler sees
+ * the whole access path of each specialization at once.
+ */
+#ifndef SIMULATION_TPP
+#define SIMULATION_TPP
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+template <class Algo, class Tlb>
+BasicSimulation<Algo, Tlb>::BasicSimulation(int numFrames,
+                                            AlgoHandle algo,
+                                            int tlbCapacity)
+    : BasicSimulation(numFrames, std::move(algo), TLBConfig{static_cast<unsigned int>(tlbCapacity)})
+{
+}
+
+template <class Algo, class Tlb>
+BasicSimulation<Algo, Tlb>::BasicSimulation(int numFrames,
+                                            AlgoHandle algo,
+                                            const TLBConfig& tlbConfig)
+    : BasicSimulation(numFrames, std::move(algo), TLBHierarchyConfig{{tlbConfig, TLB_HIT_TIME}, {}, {}, {}})
+{
+}
+
+template <class Algo, class Tlb>
+BasicSimulation<Algo, Tlb>::BasicSimulation(int numFrames,
+                                            AlgoHandle algo,
+                                            const TLBHierarchyConfig& tlbConfig)
+    : pagingAlgorithm_(std::move(algo)), mmu_(tlbConfig),
+      l1TlbTime_(tlbConfig.l1.latency), l2TlbTime_(tlbConfig.l2.latency)
+{
+    mainMemory_.resize(numFrames);
+    for (auto& f : mainMemory_) {
+        f.pageId = -1;
+        f.referencedBit = false;
+        f.dirtyBit = false;
+        f.lastAccessTime = 0;
+        f.loadTime = 0;
+        f.accessCounter = 0;
+    }
+    // Hand out frames in ascending order, like the former linear scan.
+    freeFrames_.reserve(numFrames);
+    for (int i = numFrames - 1; i >= 0; --i) freeFrames_.push_back(i);
+    frameOwner_.assign(numFrames, nullptr);
+
+    counters_.resize(1 + kMaxProcesses);
+    cur_ = &counters_[0];
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::handleMemoryAccess(const MemoryAccessEvent& event) {
+    double accessTime = 0.0;
+    int        pageId  = event.pageId();
+    const bool isWrite = event.write();
+    if (event.isAddress()) [[unlikely]] pageId = translateAddress(event);
+
+    // Step header for UI
+    ++stepCounter_;
+    stepWrite_ = isWrite;
+    log(LogEventKind::Step, pageId);
+
+    // Route the access to its table process: an ASID switch, no TLB flush.
+    if (!processes_.empty()) {
+        const auto& slot = processes_[event.processId()];
+        if (slot.process && slot.process.get() != mmu_.currentProcess) {
+            contextSwitch(event.processId());
+        }
+    }
+
+    Counters& c = *cur_;
+    c.accesses++;
+
+    if (!mmu_.currentProcess) {
+        log(LogEventKind::NoProcess, pageId);
+        return;
+    }
+
+    // Bounds check for page table access
+    PageTable& table = mmu_.currentProcess->page_table;
+    if (pageId < 0 || static_cast<std::uint64_t>(pageId) >= table.numPages()) {
+        log(LogEventKind::InvalidPage, pageId, -1,
+            static_cast<int>(std::min<std::uint64_t>(table.numPages(), INT_MAX + 1ull) - 1));
+        return;
+    }
+
+    const AddressSpace& space = mmu_.currentProcess->address_space;
+    const PageSize size = space.hasHugeMappings() ? space.pageSize(pageId) : PageSize::Base;
+    const bool     huge = size != PageSize::Base;
+    if (huge) c.hugeAccesses++;
+
+    // 1) TLB lookup (L1, then L2 if configured)
+    int frameIndex = mmu_.l1(huge).lookup(pageId);
+    accessTime += l1TlbTime_; // cost to probe the TLB, hit or miss
+    if (frameIndex != -1) {
+        log(LogEventKind::TlbHit, pageId, frameIndex);
+    } else if (mmu_.hasSTLB()) {
+        accessTime += l2TlbTime_;
+        frameIndex = mmu_.lookupSTLB(pageId, huge);
+        if (frameIndex != -1) {
+            c.l2TlbHits++;
+            log(LogEventKind::StlbHit, pageId, frameIndex);
+        } else {
+            c.l2TlbMisses++;
+        }
+    }
+
+    if (frameIndex != -1) {
+        // TLB-Hit
+        c.tlbHits++;
+
+        // A resident page's key for the paging algorithm is its frame.
+        auto& frame = mainMemory_[frameIndex];
+        frame.referencedBit = true;
+        if (isWrite) {
+            frame.dirtyBit = true;
+            policy().onWrite(frameIndex);
+            log(LogEventKind::DirtySet, pageId, frameIndex);
+        }
+        policy().memoryAccess(frameIndex);
+    } else {
+        // TLB-Miss: walk the page table; levels above the leaf cost extra.
+        c.tlbMisses++;
+        log(LogEventKind::TlbMiss, pageId);
+
+        int walkLevels = 0;
+        const PageTableEntry* pte = table.find(static_cast<std::uint64_t>(pageId), walkLevels);
+        // Huge pages are leaves one (2 MiB) or two (1 GiB) levels further up.
+        if (huge) walkLevels = std::max(1, walkLevels - (size == PageSize::Huge1G ? 2 : 1));
+        c.walkLevels += static_cast<unsigned long>(walkLevels);
+        accessTime   += (walkLevels - 1) * pageWalkLevelTime_;
+
+        if (!pte || !pte->isPresent) {
+            // Page Fault
+            c.pageFaults++;
+            if (huge) c.hugeFaults++;
+            accessTime += PAGE_FAULT_TIME;
+            log(LogEventKind::PageFault, pageId);
+            // *** FIX: pass write flag for correct signature ***
+            handlePageFault(pageId, isWrite);
+        } else {
+            // Page Hit in RAM
+            frameIndex = pte->frameIndex;
+            accessTime += MEMORY_ACCESS_TIME;
+
+            log(LogEventKind::PageHit, pageId, frameIndex);
+
+            auto& frame = mainMemory_[frameIndex];
+            frame.referencedBit = true;
+            if (isWrite) {
+                frame.dirtyBit = true;
+                policy().onWrite(frameIndex);
+                log(LogEventKind::DirtySet, pageId, frameIndex);
+            }
+
+            policy().memoryAccess(frameIndex);
+            mmu_.fill(pageId, frameIndex, huge);
+            log(LogEventKind::TlbUpdate, pageId, frameIndex);
+        }
+    }
+
+    c.accessTime += accessTime;
+}
+
+template <class Algo, class Tlb>
+int BasicSimulation<Algo, Tlb>::translateAddress(const MemoryAccessEvent& event) {
+    addressAccesses_ = true;
+    Process* p = process(event.processId());
+    if (!p) p = mmu_.currentProcess;
+    return p ? p->address_space.translate(event.address()) : -1;
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::runBatch(std::span<const MemoryAccessEvent> events) {
+    for (const auto& ev : events) handleMemoryAccess(ev);
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::handlePageFault(int requestedPageId, bool writeAccess) {
+    const AddressSpace& space = mmu_.currentProcess->address_space;
+    const PageSize size = space.hasHugeMappings() ? space.pageSize(requestedPageId) : PageSize::Base;
+    const bool     huge = size != PageSize::Base;
+
+    // 1) take a free frame, if any
+    int targetFrame = -1;
+    if (huge) {
+        targetFrame = allocateHugeFrames(space.framesPerPage(size), requestedPageId);
+    } else if (!freeFrames_.empty()) {
+        targetFrame = freeFrames_.back();
+        freeFrames_.pop_back();
+        log(LogEventKind::FreeFrame, requestedPageId, targetFrame);
+    } else {
+        // 2) no free frame → evict
+        targetFrame = policy().selectVictimPage();
+        const int oldPage = mainMemory_[targetFrame].pageId;
+
+        log(LogEventKind::Evict, requestedPageId, targetFrame, oldPage);
+
+        // Invalidate old mapping (in the owning process) + TLB
+        Process* owner = frameOwner_[targetFrame];
+        int levels = 0;
+        if (oldPage != -1 && owner) {
+            if (PageTableEntry* old = owner->page_table.find(static_cast<std::uint64_t>(oldPage), levels)) {
+                old->isPresent  = false;
+                old->frameIndex = -1;
+            }
+        }
+        mmu_.invalidateFrame(targetFrame);
+        log(LogEventKind::TlbInvalidate, requestedPageId, targetFrame);
+        releaseTailFrames(targetFrame);
+    }
+
+    // 3) map new page
+    auto& frame = mainMemory_[targetFrame];
+    frame.pageId        = requestedPageId;
+    frame.referencedBit = true;   // this access references it
+    frame.dirtyBit      = writeAccess; // set now; algorithm gets onWrite() below
+
+    auto& pte = mmu_.currentProcess->page_table.at(static_cast<std::uint64_t>(requestedPageId));
+    pte.frameIndex = targetFrame;
+    pte.isPresent  = true;
+    frameOwner_[targetFrame] = mmu_.currentProcess;
+
+    // Update TLB
+    mmu_.fill(requestedPageId, targetFrame, huge);
+    log(LogEventKind::TlbUpdate, requestedPageId, targetFrame);
+
+    // To tell the algorithm that the page is loaded into 'targetFrame'.
+    // The algorithm knows the page by its frame while it stays resident, so
+    // its per-page state is bounded by the frame count, not the address space.
+    policy().pageLoaded(targetFrame, targetFrame);
+
+    // Then record that this very access referenced the page
+    policy().memoryAccess(targetFrame);
+
+    // If this access was a write, inform the algorithm so it can mark dirty
+    if (writeAccess) {
+        policy().onWrite(targetFrame);
+        log(LogEventKind::DirtySet, requestedPageId, targetFrame);
+    }
+}
+
+template <class Algo, class Tlb>
+int BasicSimulation<Algo, Tlb>::allocateHugeFrames(std::uint64_t count, int requestedPageId) {
+    if (count > mainMemory_.size()) {
+        throw std::logic_error("Simulation: huge page needs " + std::to_string(count)
+                               + " frames, memory has " + std::to_string(mainMemory_.size()));
+    }
+    // Evict until enough frames are free; physical contiguity is not modelled.
+    while (freeFrames_.size() < count) {
+        const int victim  = policy().selectVictimPage();
+        const int oldPage = mainMemory_[victim].pageId;
+        log(LogEventKind::Evict, requestedPageId, victim, oldPage);
+
+        Process* owner = frameOwner_[victim];
+        int levels = 0;
+        if (oldPage != -1 && owner) {
+            if (PageTableEntry* old = owner->page_table.find(static_cast<std::uint64_t>(oldPage), levels)) {
+                old->isPresent  = false;
+                old->frameIndex = -1;
+            }
+        }
+        mmu_.invalidateFrame(victim);
+        log(LogEventKind::TlbInvalidate, requestedPageId, victim);
+        releaseTailFrames(victim);
+        mainMemory_[victim]  = PageFrame{};
+        frameOwner_[victim]  = nullptr;
+        freeFrames_.push_back(victim);
+    }
+
+    // The first frame holds the mapping; the others are reserved with it.
+    const int head = freeFrames_.back();
+    freeFrames_.pop_back();
+    log(LogEventKind::FreeFrame, requestedPageId, head);
+    if (tailFrames_.size() < mainMemory_.size()) tailFrames_.resize(mainMemory_.size());
+    std::vector<int>& tails = tailFrames_[head];
+    for (std::uint64_t i = 1; i < count; ++i) {
+        const int f = freeFrames_.back();
+        freeFrames_.pop_back();
+        mainMemory_[f].pageId = requestedPageId;
+        tails.push_back(f);
+    }
+    return head;
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::releaseTailFrames(int headFrame) {
+    if (static_cast<std::size_t>(headFrame) >= tailFrames_.size()) return;
+    std::vector<int>& tails = tailFrames_[headFrame];
+    for (int f : tails) {
+        mainMemory_[f] = PageFrame{};
+        freeFrames_.push_back(f);
+    }
+    tails.clear();
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::releaseFrame(int frameIndex) {
+    if (frameIndex < 0 || frameIndex >= static_cast<int>(frameOwner_.size())) return;
+    if (Process* owner = frameOwner_[frameIndex]) freeFrame(frameIndex, *owner);
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::releaseProcessFrames(Process& process) {
+    process.page_table.forEachPresent([&](std::uint64_t, const PageTableEntry& pte) {
+        freeFrame(pte.frameIndex, process);
+    });
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::freeFrame(int frameIndex, Process& process) {
+    if (frameIndex < 0 || frameIndex >= static_cast<int>(mainMemory_.size())) return;
+    auto& frame = mainMemory_[frameIndex];
+    const int pageId = frame.pageId;
+    if (pageId == -1) return;
+
+    PageTable& table = process.page_table;
+    if (static_cast<std::uint64_t>(pageId) < table.numPages()) {
+        int levels = 0;
+        PageTableEntry* pte = table.find(static_cast<std::uint64_t>(pageId), levels);
+        if (pte && pte->frameIndex == frameIndex) {
+            pte->isPresent  = false;
+            pte->frameIndex = -1;
+        }
+    }
+    // TLB entries are found by frame, whichever address space they belong to.
+    mmu_.invalidateFrame(frameIndex);
+    policy().pageUnloaded(frameIndex, frameIndex);
+
+    releaseTailFrames(frameIndex);
+    frame = PageFrame{};
+    frameOwner_[frameIndex] = nullptr;
+    freeFrames_.push_back(frameIndex);
+    log(LogEventKind::FrameReleased, pageId, frameIndex);
+}
+
+template <class Algo, class Tlb>
+Process& BasicSimulation<Algo, Tlb>::addProcess(unsigned char id, std::uint64_t numVirtualPages, PageTableKind kind) {
+    if (processes_.empty()) processes_.resize(kMaxProcesses);
+    ProcessSlot& slot = processes_[id];
+    if (slot.process) {
+        throw std::invalid_argument("Simulation: process " + std::to_string(id) + " already exists");
+    }
+    slot.process = std::make_unique<Process>(id, numVirtualPages, kind);
+    return *slot.process;
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::removeProcess(unsigned char id) {
+    Process* p = process(id);
+    if (!p) return;
+    releaseProcessFrames(*p);
+    mmu_.tlb.flushASID(id);
+    mmu_.stlb.flushASID(id);
+    mmu_.hugeTlb.flushASID(id);
+    if (mmu_.currentProcess == p) {
+        mmu_.switchProcess(nullptr);
+        bindProcess(nullptr);
+    }
+    processes_[id].process.reset();
+
+    // Keep its accesses in the totals; a later process with this ID starts at zero.
+    addCounters(counters_[0], counters_[1 + id]);
+    counters_[1 + id] = Counters{};
+    if (cur_ == &counters_[1 + id]) cur_ = &counters_[0];
+}
+
+template <class Algo, class Tlb>
+Process* BasicSimulation<Algo, Tlb>::process(unsigned char id) const {
+    return processes_.empty() ? nullptr : processes_[id].process.get();
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::switchProcess(unsigned char id) {
+    Process* p = process(id);
+    if (!p) throw std::invalid_argument("Simulation: no process " + std::to_string(id));
+    mmu_.switchProcess(p);
+    bindProcess(p);
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::contextSwitch(unsigned char id) {
+    ++contextSwitches_;
+    Process* p = processes_[id].process.get();
+    mmu_.switchProcess(p);
+    bindProcess(p);
+    log(LogEventKind::ContextSwitch, -1, -1, id);
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::bindProcess(Process* process) {
+    const bool owned = process && !processes_.empty()
+                    && processes_[process->process_id].process.get() == process;
+    cur_ = owned ? &counters_[1 + process->process_id] : &counters_[0];
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::dispatchLog(LogEventKind kind, int page, int frame, int aux) {
+    LogRecord r;
+    r.step  = stepCounter_;
+    r.page  = page;
+    r.frame = frame;
+    r.aux   = aux;
+    r.kind  = kind;
+    r.write = stepWrite_;
+    if (logSink_) logSink_->record(r);
+    if (logger_)  logger_(formatLogRecord(r));
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::printStatistics() const {
+    auto s = stats();
+    std::cout << "\n=== Stats ===\n"
+              << "Accesses      : " << s.accesses << "\n"
+              << "TLB hits/miss : " << s.tlbHits << " / " << s.tlbMisses
+              << " (hit " << s.tlbHitRate*100.0 << "%)\n";
+    if (mmu_.hasSTLB()) {
+        std::cout << "  L1 hits/miss: " << s.l1TlbHits << " / " << s.l1TlbMisses << "\n"
+                  << "  L2 hits/miss: " << s.l2TlbHits << " / " << s.l2TlbMisses << "\n";
+    }
+    std::cout << "Page faults   : " << s.pageFaults
+              << " (rate " << s.pageFaultRate*100.0 << "%)\n"
+              << "Avg time (us) : " << s.avgAccessTimeUs << "\n";
+    if (addressAccesses_) {
+        std::cout << "Huge pages    : " << s.hugePageAccesses << " accesses, "
+                  << s.hugePageFaults << " faults\n"
+                  << "TLB reach     : " << (s.tlbReachBytes >> 10) << " KiB";
+        if (mmu_.hasSTLB()) std::cout << " (L2 " << (s.stlbReachBytes >> 10) << " KiB)";
+        std::cout << "\n";
+    }
+    if (s.pageWalkLevels > s.tlbMisses) { // some walk went through a radix table
+        std::cout << "Walk levels   : " << s.pageWalkLevels << " (avg "
+                  << (s.tlbMisses ? double(s.pageWalkLevels) / s.tlbMisses : 0.0) << " per miss)\n"
+                  << "Page tables   : " << s.pageTableBytes << " bytes\n"
+                  << "Policy state  : " << s.algorithmBytes << " bytes\n";
+    }
+    if (!processes_.empty()) {
+        std::cout << "Ctx switches  : " << s.contextSwitches << "\n";
+        for (std::size_t id = 0; id < processes_.size(); ++id) {
+            const Stats p = processStats(static_cast<unsigned char>(id));
+            if (p.accesses == 0) continue;
+            std::cout << "  Process " << id << ": " << p.accesses << " accesses, TLB hit "
+                      << p.tlbHitRate*100.0 << "%, page faults " << p.pageFaults << "\n";
+        }
+    }
+}
+
+template <class Algo, class Tlb>
+SimulationStats BasicSimulation<Algo, Tlb>::makeStats(const Counters& c) {
+    Stats s;
+    s.accesses        = c.accesses;
+    s.tlbHits         = c.tlbHits;
+    s.tlbMisses       = c.tlbMisses;
+    s.l1TlbHits       = c.tlbHits - c.l2TlbHits;
+    s.l1TlbMisses     = c.tlbMisses + c.l2TlbHits;
+    s.l2TlbHits       = c.l2TlbHits;
+    s.l2TlbMisses     = c.l2TlbMisses;
+    s.pageFaults      = c.pageFaults;
+    s.pageWalkLevels  = c.walkLevels;
+    s.hugePageAccesses = c.hugeAccesses;
+    s.hugePageFaults  = c.hugeFaults;
+    s.avgAccessTimeUs = (c.accesses ? c.accessTime / c.accesses : 0.0);
+    s.tlbHitRate      = (c.accesses ? double(c.tlbHits)    / c.accesses : 0.0);
+    s.pageFaultRate   = (c.accesses ? double(c.pageFaults) / c.accesses : 0.0);
+    return s;
+}
+
+template <class Algo, class Tlb>
+void BasicSimulation<Algo, Tlb>::addCounters(Counters& into, const Counters& c) {
+    into.accesses    += c.accesses;
+    into.tlbHits     += c.tlbHits;
+    into.tlbMisses   += c.tlbMisses;
+    into.l2TlbHits   += c.l2TlbHits;
+    into.l2TlbMisses += c.l2TlbMisses;
+    into.pageFaults  += c.pageFaults;
+    into.walkLevels  += c.walkLevels;
+    into.hugeAccesses += c.hugeAccesses;
+    into.hugeFaults  += c.hugeFaults;
+    into.accessTime  += c.accessTime;
+}
+
+template <class Algo, class Tlb>
+SimulationStats BasicSimulation<Algo, Tlb>::stats() const {
+    Counters total;
+    for (const Counters& c : counters_) addCounters(total, c);
+    Stats s = makeStats(total);
+    s.contextSwitches = contextSwitches_;
+    s.pageTableBytes  = pageTableBytes();
+    s.algorithmBytes  = policy().footprintBytes();
+    s.tlbReachBytes   = reachBytes(mmu_.tlb, -1) + reachBytes(mmu_.hugeTlb, -1);
+    s.stlbReachBytes  = reachBytes(mmu_.stlb, -1);
+    return s;
+}
+
+template <class Algo, class Tlb>
+SimulationStats BasicSimulation<Algo, Tlb>::processStats(unsigned char id) const {
+    Stats s = makeStats(counters_[1 + id]);
+    if (const Process* p = process(id)) s.pageTableBytes = p->page_table.footprintBytes();
+    s.tlbReachBytes  = reachBytes(mmu_.tlb, id) + reachBytes(mmu_.hugeTlb, id);
+    s.stlbReachBytes = reachBytes(mmu_.stlb, id);
+    return s;
+}
+
+template <class Algo, class Tlb>
+std::uint64_t BasicSimulation<Algo, Tlb>::reachBytes(const Tlb& tlb, int asid) const {
+    std::uint64_t bytes = 0;
+    for (const TLBEntry& e : tlb.entries()) {
+        if (asid >= 0 && e.asid != asid) continue;
+        // Entries of table processes belong to their ASID, all others to the current process.
+        const Process* p = process(e.asid);
+        if (!p) p = mmu_.currentProcess;
+        bytes += p ? p->address_space.bytesOf(e.page_index) : AddressSpace::kDefaultPageBytes;
+    }
+    return bytes;
+}
+
+template <class Algo, class Tlb>
+std::size_t BasicSimulation<Algo, Tlb>::pageTableBytes() const {
+    std::size_t bytes = 0;
+    for (const ProcessSlot& slot : processes_) {
+        if (slot.process) bytes += slot.process->page_table.footprintBytes();
+    }
+    if (mmu_.currentProcess && process(mmu_.currentProcess->process_id) != mmu_.currentProcess) {
+        bytes += mmu_.currentProcess->page_table.footprintBytes();
+    }
+    return bytes;
+}
+
+#endif // SIMULATION_TPP
@@ -0,0 +1,87 @@
+/**
+ * @file SimulationRegistry.cpp
+ * @brief Name table of the built-in replacement algorithms.
+ */
+#include "SimulationRegistry.h"
+
+#include <stdexcept>
+
+namespace {
+
+/// One built-in algorithm: its name and both ways of building it.
+struct AlgorithmEntry {
+    const char* name;
+    std::unique_ptr<PagingAlgorithm> (*makeAlgorithm)();
+    std::unique_ptr<SimulationRunner> (*makeStatic)(int, const TLBHierarchyConfig&);
+};
+
+template <class Algo>
+std::unique_ptr<PagingAlgorithm> makeAlgorithm() {
+    return std::make_unique<Algo>();
+}
+
+template <class Algo>
+std::unique_ptr<SimulationRunner> makeStatic(int numFrames, const TLBHierarchyConfig& tlbConfig) {
+    return std::make_unique<StaticSimulationRunner<Algo>>(numFrames, tlbConfig);
+}
+
+template <class Algo>
+constexpr AlgorithmEntry entry(const char* name) {
+    return AlgorithmEntry{name, &makeAlgorithm<Algo>, &makeStatic<Algo>};
+}
+
+constexpr AlgorithmEntry kAlgorithms[] = {
+    entry<FIFOAlgorithm>("fifo"),
+    entry<LRUAlgorithm>("lru"),
+    entry<NRUAlgorithm>("nru"),
+    entry<NFUAlgorithm>("nfu"),
+    entry<NFUNoAgingAlgorithm>("nfu-noaging"),
+    entry<SecondChanceAlgorithm>("second-chance"),
+    entry<ClockAlgorithm>("clock"),
+};
+
+const AlgorithmEntry& find(const std::string& name, const char* caller) {
+    for (const auto& e : kAlgorithms) {
+        if (name == e.name) return e;
+    }
+    if (name == "opt") {
+        throw std::invalid_argument(std::string(caller) + ": 'opt' needs the trace's NextUseIndex"
+                                    " (use OPTAlgorithm or makeOPTSimulation)");
+    }
+    throw std::invalid_argument(std::string(caller) + ": unknown algorithm '" + name + "'");
+}
+
+} // namespace
+
+const std::vector<std::string>& pagingAlgorithmNames() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> v;
+        for (const auto& e : kAlgorithms) v.emplace_back(e.name);
+        return v;
+    }();
+    return names;
+}
+
+std::unique_ptr<PagingAlgorithm> makePagingAlgorithm(const std::string& name) {
+    return find(name, "makePagingAlgorithm").makeAlgorithm();
+}
+
+std::unique_ptr<SimulationRunner> makeStaticSimulation(const std::string& name, int numFrames,
+                                                       const TLBHierarchyConfig& tlbConfig) {
+    return find(name, "makeStaticSimulation").makeStatic(numFrames, tlbConfig);
+}
+
+std::unique_ptr<SimulationRunner> makeStaticSimulation(const std::string& name, int numFrames,
+                                                       const TLBConfig& tlbConfig) {
+    return makeStaticSimulation(name, numFrames, TLBHierarchyConfig{TLBLevelConfig{tlbConfig}, {}, {}, {}});
+}
+
+std::unique_ptr<SimulationRunner> makeOPTSimulation(const NextUseIndex& future, int numFrames,
+                                                    const TLBHierarchyConfig& tlbConfig) {
+    return std::make_unique<StaticSimulationRunner<OPTAlgorithm>>(numFrames, OPTAlgorithm(future), tlbConfig);
+}
+
+std::unique_ptr<SimulationRunner> makeOPTSimulation(const NextUseIndex& future, int numFrames,
+                                                    const TLBConfig& tlbConfig) {
+    return makeOPTSimulation(future, numFrames, TLBHierarchyConfig{TLBLevelConfig{tlbConfig}, {}, {}, {}});
+}
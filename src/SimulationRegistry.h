@@ -0,0 +1,137 @@
+/**
+ * @file SimulationRegistry.h
+ * @brief Built-in replacement algorithms by name, as run-time or statically bound simulations.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * auto sim = makeStaticSimulation("lru", 256, TLBConfig{64});
+ * sim->addProcess(1, 1 << 16);
+ * sim->runBatch(events);       // one virtual call per batch, none per access
+ * sim->printStatistics();
+ * @endcode
+ */
+#ifndef SIMULATION_REGISTRY_H
+#define SIMULATION_REGISTRY_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Simulation.h"
+#include "core/PageTable.h"
+#include "core/TLB.h"
+#include "core/algorithms/ClockAlgorithm.h"
+#include "core/algorithms/FIFOAlgorithm.h"
+#include "core/algorithms/LRUAlgorithm.h"
+#include "core/algorithms/NFUAlgorithm.h"
+#include "core/algorithms/NFUNoAgingAlgorithm.h"
+#include "core/algorithms/NRUAlgorithm.h"
+#include "core/algorithms/OPTAlgorithm.h"
+#include "core/algorithms/SecondChanceAlgorithm.h"
+
+// Each compiled once, in its own unit under src/static/.
+extern template class BasicSimulation<FIFOAlgorithm>;
+extern template class BasicSimulation<LRUAlgorithm>;
+extern template class BasicSimulation<NRUAlgorithm>;
+extern template class BasicSimulation<NFUAlgorithm>;
+extern template class BasicSimulation<NFUNoAgingAlgorithm>;
+extern template class BasicSimulation<SecondChanceAlgorithm>;
+extern template class BasicSimulation<ClockAlgorithm>;
+extern template class BasicSimulation<OPTAlgorithm>;
+
+/** @return Names accepted by @ref makePagingAlgorithm and @ref makeStaticSimulation. */
+const std::vector<std::string>& pagingAlgorithmNames();
+
+/**
+ * @brief Create a replacement algorithm by name.
+ * @param name One of @ref pagingAlgorithmNames (e.g. "lru", "second-chance").
+ * @throws std::invalid_argument for unknown names.
+ */
+std::unique_ptr<PagingAlgorithm> makePagingAlgorithm(const std::string& name);
+
+/**
+ * @brief A simulation whose algorithm was chosen by name, behind one interface.
+ * @details Type-erases a @ref BasicSimulation specialization. The virtual
+ *          call happens once per call of this interface; inside
+ *          @ref runBatch every access goes to the statically bound
+ *          algorithm. Use @ref StaticSimulationRunner::simulation for the
+ *          rest of the simulation API.
+ */
+class SimulationRunner {
+public:
+    virtual ~SimulationRunner() = default;
+
+    /** @see BasicSimulation::addProcess */
+    virtual Process& addProcess(unsigned char id, std::uint64_t numVirtualPages,
+                                PageTableKind kind = PageTableKind::Dense) = 0;
+    /** @see BasicSimulation::process */
+    virtual Process* process(unsigned char id) const = 0;
+    /** @see BasicSimulation::handleMemoryAccess */
+    virtual void handleMemoryAccess(const MemoryAccessEvent& event) = 0;
+    /** @see BasicSimulation::runBatch */
+    virtual void runBatch(std::span<const MemoryAccessEvent> events) = 0;
+    /** @see BasicSimulation::stats */
+    virtual SimulationStats stats() const = 0;
+    /** @see BasicSimulation::printStatistics */
+    virtual void printStatistics() const = 0;
+};
+
+/** @brief @ref SimulationRunner over a @ref BasicSimulation with algorithm @p Algo. */
+template <class Algo>
+class StaticSimulationRunner final : public SimulationRunner {
+public:
+    StaticSimulationRunner(int numFrames, const TLBHierarchyConfig& tlbConfig)
+        : sim_(numFrames, Algo{}, tlbConfig) {}
+    /** @brief Bind an already constructed algorithm (e.g. an @ref OPTAlgorithm over its index). */
+    StaticSimulationRunner(int numFrames, Algo algo, const TLBHierarchyConfig& tlbConfig)
+        : sim_(numFrames, std::move(algo), tlbConfig) {}
+
+    Process& addProcess(unsigned char id, std::uint64_t numVirtualPages,
+                        PageTableKind kind = PageTableKind::Dense) override {
+        return sim_.addProcess(id, numVirtualPages, kind);
+    }
+    Process* process(unsigned char id) const override { return sim_.process(id); }
+    void handleMemoryAccess(const MemoryAccessEvent& event) override { sim_.handleMemoryAccess(event); }
+    void runBatch(std::span<const MemoryAccessEvent> events) override { sim_.runBatch(events); }
+    SimulationStats stats() const override { return sim_.stats(); }
+    void printStatistics() const override { sim_.printStatistics(); }
+
+    /** @return The underlying simulation. */
+    BasicSimulation<Algo>& simulation() { return sim_; }
+
+private:
+    BasicSimulation<Algo> sim_;
+};
+
+/**
+ * @brief Create a statically bound simulation by algorithm name.
+ * @param name      One of @ref pagingAlgorithmNames.
+ * @param numFrames Number of physical frames.
+ * @param tlbConfig TLB hierarchy (see BasicSimulation's constructors).
+ * @throws std::invalid_argument for unknown names (including "opt", which
+ *         needs its trace: use @ref makeOPTSimulation) or unsupported TLB shapes.
+ */
+std::unique_ptr<SimulationRunner> makeStaticSimulation(const std::string& name, int numFrames,
+                                                       const TLBHierarchyConfig& tlbConfig);
+
+/** @brief As above, with a single TLB level (hit time 1, like Simulation's TLBConfig constructor). */
+std::unique_ptr<SimulationRunner> makeStaticSimulation(const std::string& name, int numFrames,
+                                                       const TLBConfig& tlbConfig);
+
+/**
+ * @brief Create a statically bound OPT simulation for one trace.
+ * @param future    Next-use index of the trace that will be replayed (must outlive the simulation).
+ * @param numFrames Number of physical frames.
+ * @param tlbConfig TLB hierarchy (see BasicSimulation's constructors).
+ */
+std::unique_ptr<SimulationRunner> makeOPTSimulation(const NextUseIndex& future, int numFrames,
+                                                    const TLBHierarchyConfig& tlbConfig);
+
+/** @brief As above, with a single TLB level. */
+std::unique_ptr<SimulationRunner> makeOPTSimulation(const NextUseIndex& future, int numFrames,
+                                                    const TLBConfig& tlbConfig);
+
+#endif // SIMULATION_REGISTRY_H
@@ -3,45 +3,74 @@
  * @brief Implementation of trace file loading and scheduling.
  */
 #include "TraceLoader.h"
-#include <fstream>
-#include <sstream>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 #include "core/MemoryAccessEvent.h"
-#include "des/Event.h"
+#include "trace/BinaryTrace.h"
+#include "trace/Synthetic.h"
+#include "trace/TextTraceParser.h"
 
+std::unique_ptr<TraceSource> openTrace(const std::string& filename) {
+    if (filename.rfind(kSyntheticPrefix, 0) == 0) {
+        return makeSyntheticTrace(filename.substr(sizeof(kSyntheticPrefix) - 1));
+    }
+    if (BinaryTraceReader::isBinaryTrace(filename)) {
+        return std::make_unique<BinaryTraceReader>(filename);
+    }
+    return std::make_unique<TextTraceParser>(filename);
+}
 
 void loadTrace(const std::string& filename,
                EventQueue& eq,
                Simulation* sim,
                double startTime,
                double delta) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    std::unique_ptr<TraceSource> source;
+    try {
+        source = openTrace(filename);
+    } catch (const std::exception&) { // unreadable file or bad synthetic spec
         std::cerr << "Cannot open trace file: " << filename << std::endl;
         return;
     }
 
-    std::string line;
+    std::vector<MemoryAccessEvent> chunk;
     double t = startTime;
+    while (source->next(chunk, 4096) > 0) {
+        for (const auto& ev : chunk) {
+            eq.schedule(t, [sim, ev]() {
+                sim->handleMemoryAccess(ev);
+            });
+            t += delta;
+        }
+        chunk.clear();
+    }
+}
 
-    while (std::getline(file, line)) {
-        // Trim leading whitespace
-        std::string trimmed = line;
-        trimmed.erase(0, trimmed.find_first_not_of(" \t\r\n"));
-        if (trimmed.empty() || trimmed[0] == '#') continue;
-
-        std::istringstream iss(trimmed);
-        int  pageId; char rw = 'R';
-        iss >> pageId;
-        if (iss.good()) iss >> rw;
-        bool write = (rw == 'W' || rw == 'w');
-
-        Event* e = new Event([sim, pageId, write]() {
-            MemoryAccessEvent ev(pageId, write);
-            sim->handleMemoryAccess(ev);
-        }, t);
+std::size_t runTrace(const std::string& filename,
+                     Simulation& sim,
+                     std::size_t chunkSize) {
+    std::unique_ptr<TraceSource> source;
+    try {
+        source = openTrace(filename);
+    } catch (const std::exception&) { // unreadable file or bad synthetic spec
+        std::cerr << "Cannot open trace file: " << filename << std::endl;
+        return 0;
+    }
+    return runTrace(*source, sim, chunkSize);
+}
 
-        eq.AddEvent(e);
-        t += delta;
+std::size_t runTrace(TraceSource& source,
+                     Simulation& sim,
+                     std::size_t chunkSize) {
+    if (chunkSize == 0) chunkSize = 1;
+    std::vector<MemoryAccessEvent> chunk;
+    chunk.reserve(chunkSize);
+    std::size_t total = 0;
+    while (source.next(chunk, chunkSize) > 0) {
+        sim.runBatch(chunk);
+        total += chunk.size();
+        chunk.clear();
     }
+    return total;
 }
@@ -5,15 +5,37 @@
 #ifndef TRACELOADER_H
 #define TRACELOADER_H
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include "des/EventQueue.h"
 #include "Simulation.h"
+#include "trace/TraceSource.h"
+
+/// Prefix of the names that @ref openTrace hands to @ref makeSyntheticTrace.
+inline constexpr char kSyntheticPrefix[] = "synthetic:";
+
+/**
+ * @brief Open a trace file with the matching reader.
+ * @details Files starting with the binary trace magic are read with
+ *          @ref BinaryTraceReader, everything else with @ref TextTraceParser.
+ *          A name "synthetic:<spec>" (e.g. "synthetic:zipf:pages=65536,skew=1.1")
+ *          opens a generator instead, see @ref makeSyntheticTrace.
+ * @param filename Path to the trace file, or a synthetic spec.
+ * @return Streaming source over the file.
+ * @throws std::runtime_error if the file cannot be opened.
+ * @throws std::invalid_argument for a malformed synthetic spec.
+ */
+std::unique_ptr<TraceSource> openTrace(const std::string& filename);
 
 /**
  * @brief Load a trace of page accesses and schedule them into the event queue.
- * @details Each line: "pageId [R|W]". Lines starting with '#' are ignored.
+ * @details Each line: "[pid:]pageId [R|W]" or "[pid:]0xaddress [R|W]".
+ *          Lines starting with '#' are ignored.
+ *          Parsing uses @ref TextTraceParser; malformed lines are reported and skipped.
+ *          Binary traces (see @ref BinaryTraceWriter) are accepted as well.
  * @param filename Path to the trace file.
- * @param eq Event queue to schedule into (takes ownership of created events).
+ * @param eq Event queue to schedule into (events are stored in its pool).
  * @param sim Simulation to call when events fire.
  * @param startTime Time of first event.
  * @param delta Time spacing between events.
@@ -24,4 +46,29 @@ void loadTrace(const std::string& filename,
                double startTime = 1.0,
                double delta = 1.0);
 
+/**
+ * @brief Replay a trace directly into a simulation, bypassing the EventQueue.
+ * @details Same file format as @ref loadTrace. The file is parsed in chunks of
+ *          @p chunkSize accesses into one reused buffer, and each chunk is handed
+ *          to @ref Simulation::runBatch. Use this when event timing is irrelevant.
+ * @param filename Path to the trace file.
+ * @param sim Simulation receiving the accesses.
+ * @param chunkSize Number of accesses parsed per batch.
+ * @return Number of accesses replayed (0 if the file cannot be opened).
+ */
+std::size_t runTrace(const std::string& filename,
+                     Simulation& sim,
+                     std::size_t chunkSize = 4096);
+
+/**
+ * @brief Replay any trace source directly into a simulation.
+ * @param source Stream of accesses (consumed).
+ * @param sim Simulation receiving the accesses.
+ * @param chunkSize Number of accesses pulled per batch.
+ * @return Number of accesses replayed.
+ */
+std::size_t runTrace(TraceSource& source,
+                     Simulation& sim,
+                     std::size_t chunkSize = 4096);
+
 #endif // TRACELOADER_H
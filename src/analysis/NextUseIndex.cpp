@@ -0,0 +1,227 @@
+/**
+ * @file NextUseIndex.cpp
+ * @brief Implementation of the next-use index and its side file.
+ */
+#include "analysis/NextUseIndex.h"
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+
+#include "TraceLoader.h"
+
+namespace {
+
+constexpr char          kMagic[8] = {'P', 'S', 'N', 'E', 'X', 'T', 'U', '\0'};
+constexpr std::uint32_t kVersion  = 2;   ///< Adds the address-space layout hash.
+constexpr std::size_t   kHeaderBytes = 48;
+
+void putU32(unsigned char* p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+void putU64(unsigned char* p, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+std::uint32_t getU32(const unsigned char* p) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= std::uint32_t(p[i]) << (8 * i);
+    return v;
+}
+std::uint64_t getU64(const unsigned char* p) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= std::uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+/// What the side file must match to be reused.
+struct Fingerprint {
+    std::uint32_t pageBytes{0};
+    std::uint64_t traceBytes{0};
+    std::int64_t  traceTime{0};
+    std::uint64_t layout{0};   ///< See layoutHash().
+};
+
+/**
+ * @return FNV-1a hash of the spaces that differ from a plain
+ *         AddressSpace(pageBytes): process ID, base page size and huge
+ *         ranges. 0 if there are none, so equivalent layouts share a side file.
+ */
+std::uint64_t layoutHash(std::uint64_t pageBytes, std::span<const AddressSpace> spaces) {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    bool any = false;
+    const auto mix = [&h](std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) h = (h ^ ((v >> (8 * i)) & 0xff)) * 0x100000001b3ULL;
+    };
+    for (std::size_t pid = 0; pid < spaces.size() && pid < 256; ++pid) {
+        const AddressSpace& s = spaces[pid];
+        if (s.pageBytes() == pageBytes && !s.hasHugeMappings()) continue;
+        any = true;
+        mix(pid);
+        mix(s.pageBytes());
+        for (const auto& r : s.hugeRegions()) {
+            mix(r.begin);
+            mix(r.end);
+            mix(static_cast<std::uint64_t>(r.size));
+        }
+    }
+    return any ? h : 0;
+}
+
+Fingerprint fingerprint(const std::string& tracePath, std::uint64_t pageBytes,
+                        std::span<const AddressSpace> spaces) {
+    Fingerprint f;
+    f.pageBytes  = static_cast<std::uint32_t>(pageBytes);
+    f.layout     = layoutHash(pageBytes, spaces);
+    f.traceBytes = std::filesystem::file_size(tracePath);
+    f.traceTime  = static_cast<std::int64_t>(
+        std::filesystem::last_write_time(tracePath).time_since_epoch().count());
+    return f;
+}
+
+/// Numbers the distinct (process, page) pairs of a trace in order of first use.
+class PageNumbering {
+public:
+    PageNumbering(std::uint64_t pageBytes, std::span<const AddressSpace> spaces)
+        : spaces_(256, AddressSpace(pageBytes)) {
+        for (std::size_t pid = 0; pid < spaces.size() && pid < spaces_.size(); ++pid) spaces_[pid] = spaces[pid];
+    }
+
+    void add(std::span<const MemoryAccessEvent> events) {
+        for (const auto& ev : events) {
+            const int page = ev.isAddress() ? spaces_[ev.processId()].translate(ev.address()) : ev.pageId();
+            const std::uint64_t key = std::uint64_t{ev.processId()} << 32 | static_cast<std::uint32_t>(page);
+            const auto [it, inserted] = ids_.try_emplace(key, static_cast<std::uint32_t>(ids_.size()));
+            pages_.push_back(it->second);
+        }
+    }
+
+    const std::vector<std::uint32_t>& pages() const { return pages_; }
+    std::uint32_t count() const { return static_cast<std::uint32_t>(ids_.size()); }
+
+private:
+    std::vector<AddressSpace>                         spaces_;
+    std::unordered_map<std::uint64_t, std::uint32_t> ids_;
+    std::vector<std::uint32_t>                        pages_;
+};
+
+/** @return The mapped entries if @p sidePath is a current side file, else nullptr. */
+std::unique_ptr<MappedFile> mapSideFile(const std::string& sidePath, const Fingerprint& f) {
+    std::error_code ec;
+    if (!std::filesystem::exists(sidePath, ec)) return nullptr;
+    std::unique_ptr<MappedFile> file;
+    try {
+        file = std::make_unique<MappedFile>(sidePath);
+    } catch (const std::runtime_error&) {
+        return nullptr; // unreadable: rebuild
+    }
+    const auto* h = reinterpret_cast<const unsigned char*>(file->data());
+    if (file->size() < kHeaderBytes || std::memcmp(h, kMagic, sizeof(kMagic)) != 0
+        || getU32(h + 8) != kVersion || getU32(h + 12) != f.pageBytes
+        || getU64(h + 16) != f.traceBytes || static_cast<std::int64_t>(getU64(h + 24)) != f.traceTime
+        || getU64(h + 32) != f.layout
+        || file->size() != kHeaderBytes + getU64(h + 40) * sizeof(std::uint64_t)) {
+        return nullptr;
+    }
+    return file;
+}
+
+void writeSideFile(const std::string& sidePath, const Fingerprint& f, std::span<const std::uint64_t> next) {
+    const std::string tmp = sidePath + ".tmp";
+    std::FILE* out = std::fopen(tmp.c_str(), "wb");
+    if (!out) return;
+    unsigned char header[kHeaderBytes];
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    putU32(header + 8,  kVersion);
+    putU32(header + 12, f.pageBytes);
+    putU64(header + 16, f.traceBytes);
+    putU64(header + 24, static_cast<std::uint64_t>(f.traceTime));
+    putU64(header + 32, f.layout);
+    putU64(header + 40, next.size());
+    bool ok = std::fwrite(header, 1, sizeof(header), out) == sizeof(header);
+    if constexpr (std::endian::native == std::endian::little) {
+        ok = ok && std::fwrite(next.data(), sizeof(std::uint64_t), next.size(), out) == next.size();
+    } else {
+        unsigned char buf[8];
+        for (std::size_t i = 0; ok && i < next.size(); ++i) {
+            putU64(buf, next[i]);
+            ok = std::fwrite(buf, 1, sizeof(buf), out) == sizeof(buf);
+        }
+    }
+    ok = std::fclose(out) == 0 && ok;
+    std::error_code ec;
+    if (ok) std::filesystem::rename(tmp, sidePath, ec);
+    if (!ok || ec) std::filesystem::remove(tmp, ec);
+}
+
+} // namespace
+
+void NextUseIndex::link(const std::vector<std::uint32_t>& pages, std::uint32_t pageCount) {
+    owned_.resize(pages.size());
+    std::vector<std::uint64_t> following(pageCount, kNever); // page -> its next access after i
+    for (std::size_t i = pages.size(); i-- > 0;) {
+        owned_[i] = following[pages[i]];
+        following[pages[i]] = i;
+    }
+    next_ = owned_;
+}
+
+NextUseIndex NextUseIndex::build(TraceSource& source, std::uint64_t pageBytes,
+                                 std::span<const AddressSpace> spaces) {
+    PageNumbering numbering(pageBytes, spaces);
+    std::vector<MemoryAccessEvent> chunk;
+    while (source.next(chunk, 1 << 16) > 0) {
+        numbering.add(chunk);
+        chunk.clear();
+    }
+    NextUseIndex index;
+    index.link(numbering.pages(), numbering.count());
+    return index;
+}
+
+NextUseIndex NextUseIndex::build(std::span<const MemoryAccessEvent> events, std::uint64_t pageBytes,
+                                 std::span<const AddressSpace> spaces) {
+    PageNumbering numbering(pageBytes, spaces);
+    numbering.add(events);
+    NextUseIndex index;
+    index.link(numbering.pages(), numbering.count());
+    return index;
+}
+
+NextUseIndex NextUseIndex::loadOrBuild(const std::string& tracePath, std::uint64_t pageBytes,
+                                       const std::string& sidePath, std::span<const AddressSpace> spaces) {
+    if (tracePath.rfind(kSyntheticPrefix, 0) == 0) {
+        auto source = openTrace(tracePath); // regenerating is as cheap as reading a side file
+        return build(*source, pageBytes, spaces);
+    }
+    const std::string side = sidePath.empty() ? defaultSidePath(tracePath) : sidePath;
+    const Fingerprint f = fingerprint(tracePath, pageBytes, spaces);
+
+    if (auto file = mapSideFile(side, f)) {
+        NextUseIndex index;
+        const std::uint64_t count = (file->size() - kHeaderBytes) / sizeof(std::uint64_t);
+        if constexpr (std::endian::native == std::endian::little) {
+            // The header is a multiple of 8 bytes and mappings are page aligned.
+            index.next_ = {reinterpret_cast<const std::uint64_t*>(file->data() + kHeaderBytes), count};
+            index.mapping_ = std::move(file);
+        } else {
+            const auto* p = reinterpret_cast<const unsigned char*>(file->data() + kHeaderBytes);
+            index.owned_.resize(count);
+            for (std::uint64_t i = 0; i < count; ++i) index.owned_[i] = getU64(p + 8 * i);
+            index.next_ = index.owned_;
+        }
+        return index;
+    }
+
+    auto source = openTrace(tracePath);
+    NextUseIndex index = build(*source, pageBytes, spaces);
+    writeSideFile(side, f, index.next_);
+    return index;
+}
+
+std::string NextUseIndex::defaultSidePath(const std::string& tracePath) {
+    return tracePath + ".nextuse";
+}
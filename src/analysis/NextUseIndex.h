@@ -0,0 +1,115 @@
+/**
+ * @file NextUseIndex.h
+ * @brief Position of the next access to the same page, for every access of a trace.
+ *
+ * Side-file layout (little-endian): magic "PSNEXTU\0", u32 version, u32 page
+ * bytes, u64 trace file size, i64 trace modification time, u64 address-space
+ * layout hash, u64 access count (48 bytes), then one u64 next-use position
+ * per access.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * auto index = NextUseIndex::loadOrBuild("trace.bin"); // maps trace.bin.nextuse if current
+ * Simulation sim(64, std::make_unique<OPTAlgorithm>(index), 16);
+ * @endcode
+ */
+#ifndef ANALYSIS_NEXTUSEINDEX_H
+#define ANALYSIS_NEXTUSEINDEX_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/AddressSpace.h"
+#include "core/MemoryAccessEvent.h"
+#include "trace/MappedFile.h"
+#include "trace/TraceSource.h"
+
+/**
+ * @brief Next-use positions of a whole trace, built in one backward pass.
+ * @details Pages are identified by (process ID, page ID); address accesses
+ *          are translated with one AddressSpace per process: a copy of the
+ *          caller's space for that process ID if one is given (see @p spaces
+ *          of @ref build), else a plain AddressSpace(pageBytes). The page IDs
+ *          match a simulation's only if these are the address spaces its
+ *          processes start the trace with, huge mappings included; otherwise
+ *          a huge page counts as many base pages here and OPT works from the
+ *          wrong future distances. Entry i is the position of the next access to the
+ *          page of access i, or @ref kNever.
+ *
+ *          The forward pass only decodes and numbers the pages; the backward
+ *          pass then needs a flat array instead of a hash lookup per access.
+ *          A loaded side file is used in place through a read-only mapping.
+ */
+class NextUseIndex {
+public:
+    /// Next use of a page that is not accessed again.
+    static constexpr std::uint64_t kNever = std::numeric_limits<std::uint64_t>::max();
+
+    /**
+     * @brief Build the index from a stream of accesses.
+     * @param source    Stream of accesses (consumed).
+     * @param pageBytes Base page size for address accesses.
+     * @param spaces    Address space of process i at @p spaces[i], as the
+     *                  simulation's process starts with it (huge mappings set,
+     *                  no address translated yet); processes beyond the span
+     *                  use a plain AddressSpace(pageBytes).
+     * @throws std::invalid_argument for an unsupported page size.
+     */
+    static NextUseIndex build(TraceSource& source, std::uint64_t pageBytes = 4096,
+                              std::span<const AddressSpace> spaces = {});
+
+    /** @brief Build the index from accesses already in memory. */
+    static NextUseIndex build(std::span<const MemoryAccessEvent> events, std::uint64_t pageBytes = 4096,
+                              std::span<const AddressSpace> spaces = {});
+
+    /**
+     * @brief Map the side file of a trace, or build the index and write it.
+     * @details The side file is reused only if its version, page size, the
+     *          layout of @p spaces (base page sizes and huge ranges) and the
+     *          trace's size and modification time match; otherwise the
+     *          trace is read, the index built and the side file replaced
+     *          (through a temporary file, so readers never see half of it).
+     *          Failing to write the side file is not an error. Synthetic
+     *          traces ("synthetic:<spec>") are built without a side file.
+     * @param tracePath Text or binary trace, or a synthetic spec (see openTrace).
+     * @param pageBytes Base page size for address accesses.
+     * @param sidePath  Side file; empty uses @ref defaultSidePath.
+     * @param spaces    Per-process address spaces, as for @ref build.
+     * @throws std::runtime_error if the trace cannot be read.
+     */
+    static NextUseIndex loadOrBuild(const std::string& tracePath, std::uint64_t pageBytes = 4096,
+                                    const std::string& sidePath = {},
+                                    std::span<const AddressSpace> spaces = {});
+
+    NextUseIndex() = default;
+    NextUseIndex(NextUseIndex&&) noexcept = default;
+    NextUseIndex& operator=(NextUseIndex&&) noexcept = default;
+    NextUseIndex(const NextUseIndex&) = delete;
+    NextUseIndex& operator=(const NextUseIndex&) = delete;
+
+    /** @return @p tracePath + ".nextuse". */
+    static std::string defaultSidePath(const std::string& tracePath);
+
+    /** @return Number of accesses covered. */
+    std::uint64_t size() const { return next_.size(); }
+
+    /** @return Next use of the page of access @p i (@ref kNever past the end). */
+    std::uint64_t nextUse(std::uint64_t i) const { return i < next_.size() ? next_[i] : kNever; }
+
+    /** @return True if the entries come from a mapped side file. */
+    bool mapped() const { return mapping_ != nullptr; }
+
+private:
+    /** @brief Backward pass over dense page numbers. */
+    void link(const std::vector<std::uint32_t>& pages, std::uint32_t pageCount);
+
+    std::vector<std::uint64_t>  owned_;   ///< Entries when built in memory.
+    std::unique_ptr<MappedFile> mapping_; ///< Side file when loaded (heap-held, so moves keep next_ valid).
+    std::span<const std::uint64_t> next_;
+};
+
+#endif // ANALYSIS_NEXTUSEINDEX_H
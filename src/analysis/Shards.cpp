@@ -0,0 +1,147 @@
+/**
+ * @file Shards.cpp
+ * @brief Implementation of the fixed-size SHARDS sampler.
+ */
+#include "analysis/Shards.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+/// splitmix64 finalizer: page keys are often dense, their hashes must not be.
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27; x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+ShardsAnalyzer::ShardsAnalyzer(std::size_t maxPages, double initialRate, int pageShift)
+    : sd_(pageShift), maxPages_(maxPages) {
+    if (maxPages == 0) {
+        throw std::invalid_argument("ShardsAnalyzer: sample budget must be at least one page");
+    }
+    if (!(initialRate > 0.0 && initialRate <= 1.0)) {
+        throw std::invalid_argument("ShardsAnalyzer: sampling rate must be in (0, 1]");
+    }
+    threshold_ = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(initialRate * kHashRange));
+}
+
+std::size_t ShardsAnalyzer::bucketOf(double distance) {
+    const auto v = static_cast<std::uint64_t>(std::ceil(distance));
+    if (v < 2 * kSubBuckets) return v;
+    const int e = std::bit_width(v) - std::bit_width(unsigned{2 * kSubBuckets - 1});
+    return std::size_t(kSubBuckets) * e + (v >> e);
+}
+
+std::uint64_t ShardsAnalyzer::bucketBegin(std::size_t bucket) {
+    if (bucket < 2 * kSubBuckets) return bucket;
+    const std::size_t e = bucket / kSubBuckets - 1;
+    return (bucket % kSubBuckets + kSubBuckets) << e;
+}
+
+void ShardsAnalyzer::access(std::uint64_t key) {
+    ++accesses_;
+    const std::uint64_t h          = mix(key);
+    const std::uint64_t sampleHash = h >> 32;
+    if (sampleHash >= threshold_) return;
+
+    // Horvitz-Thompson weight: this access stands for 1/R accesses.
+    ++sampled_;
+    const double        scale    = kHashRange / double(threshold_);
+    const std::size_t   group    = h & (kGroups - 1);
+    const std::uint64_t distance = sd_.access(key);
+    if (distance == StackDistanceAnalyzer::kCold) {
+        cold_[group] += scale;
+        heap_.emplace(sampleHash, key);
+        if (heap_.size() > maxPages_) shrink();
+        return;
+    }
+    // A sampled distance d has E[d] = 1 + (D - 1) * R for true distance D.
+    const std::size_t bucket = bucketOf(1.0 + double(distance - 1) * scale);
+    if ((bucket + 1) * kGroups > hist_.size()) hist_.resize((bucket + 1) * kGroups, 0.0);
+    hist_[bucket * kGroups + group] += scale;
+}
+
+void ShardsAnalyzer::shrink() {
+    // Drop the pages with the largest hash; they would not be sampled at the lower rate.
+    while (heap_.size() > maxPages_) {
+        const std::uint64_t top = heap_.top().first;
+        while (!heap_.empty() && heap_.top().first == top) {
+            sd_.erase(heap_.top().second);
+            heap_.pop();
+        }
+        threshold_ = std::max<std::uint64_t>(1, top);
+    }
+}
+
+std::size_t ShardsAnalyzer::consume(TraceSource& source, std::size_t chunkSize) {
+    if (chunkSize == 0) chunkSize = 1;
+    std::vector<MemoryAccessEvent> chunk;
+    chunk.reserve(chunkSize);
+    std::size_t total = 0;
+    while (source.next(chunk, chunkSize) > 0) {
+        add(chunk);
+        total += chunk.size();
+        chunk.clear();
+    }
+    return total;
+}
+
+double ShardsAnalyzer::estimatedPages() const {
+    double pages = 0;
+    for (double c : cold_) pages += c;
+    return pages;
+}
+
+std::vector<MissRatioPoint> ShardsAnalyzer::missRatioCurve(std::span<const std::uint64_t> frameCounts) const {
+    // suffix[b * kGroups + g] = weight of group g at buckets >= b.
+    const std::size_t buckets = hist_.size() / kGroups;
+    std::vector<double> suffix((buckets + 1) * kGroups, 0.0);
+    for (std::size_t b = buckets; b-- > 0;) {
+        for (int g = 0; g < kGroups; ++g) {
+            suffix[b * kGroups + g] = suffix[(b + 1) * kGroups + g] + hist_[b * kGroups + g];
+        }
+    }
+
+    const bool exact = threshold_ == static_cast<std::uint64_t>(kHashRange);
+    std::vector<MissRatioPoint> curve;
+    curve.reserve(frameCounts.size());
+    for (const std::uint64_t frames : frameCounts) {
+        // Distances > frames miss; the bucket holding frames is split linearly.
+        const std::size_t b    = frames == 0 ? 0 : bucketOf(double(frames));
+        const double      end  = double(bucketBegin(b + 1));
+        const double      frac = frames == 0 ? 1.0 : (end - 1.0 - double(frames)) / (end - double(bucketBegin(b)));
+
+        double misses = 0, weight = 0, groupSum = 0, groupSq = 0;
+        int    groups = 0;
+        for (int g = 0; g < kGroups; ++g) {
+            double m = cold_[g];
+            if (b < buckets) m += suffix[(b + 1) * kGroups + g] + frac * hist_[b * kGroups + g];
+            misses += m;
+            const double total = cold_[g] + suffix[g];
+            weight += total;
+            if (total > 0) {
+                const double r = m / total;
+                groupSum += r;
+                groupSq  += r * r;
+                ++groups;
+            }
+        }
+
+        MissRatioPoint p{frames, weight > 0 ? misses / weight : 0.0, 1.0};
+        if (exact) {
+            p.errorBound = 0.0;
+        } else if (groups > 1) {
+            const double mean = groupSum / groups;
+            const double var  = std::max(0.0, groupSq / groups - mean * mean) * groups / (groups - 1);
+            p.errorBound = 2.0 * std::sqrt(var / groups);
+        }
+        curve.push_back(p);
+    }
+    return curve;
+}
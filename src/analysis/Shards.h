@@ -0,0 +1,132 @@
+/**
+ * @file Shards.h
+ * @brief Approximate LRU miss-ratio curves from a spatially hashed page sample (SHARDS).
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * ShardsAnalyzer shards(16384);          // at most 16384 sampled pages
+ * auto source = openTrace("huge.bin");
+ * shards.consume(*source);
+ * const std::vector<std::uint64_t> sizes{1024, 65536, 1 << 20};
+ * auto mrc = shards.missRatioCurve(sizes);
+ * @endcode
+ */
+#ifndef ANALYSIS_SHARDS_H
+#define ANALYSIS_SHARDS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "analysis/StackDistance.h"
+#include "core/MemoryAccessEvent.h"
+#include "trace/TraceSource.h"
+
+/** @brief One point of an estimated miss-ratio curve. */
+struct MissRatioPoint {
+    std::uint64_t frames;     ///< Memory size in pages.
+    double        missRatio;  ///< Estimated LRU miss ratio.
+    double        errorBound; ///< Half-width of an approximate 95% confidence interval.
+};
+
+/**
+ * @brief Fixed-size SHARDS: stack distances of a hashed sample of pages.
+ * @details A page is sampled when hash(page) < T, so either every access to
+ *          it is seen or none; at rate R = T / 2^32 the stack distances of the
+ *          sample, scaled up by 1/R, estimate the distances of the full trace.
+ *          Sampled pages go through a @ref StackDistanceAnalyzer. When more
+ *          than @p maxPages pages are sampled, the pages with the largest
+ *          hash are dropped and T is lowered to that hash, so memory stays
+ *          bounded by the budget, not by the trace.
+ *
+ *          Each sampled access is counted with weight 1/R at the time it is
+ *          seen. This equals the rescaling of the original fixed-size SHARDS
+ *          up to a common factor, which cancels in a ratio, and needs no
+ *          pass over the histogram when R drops. Scaled distances go into
+ *          log-linear buckets (64 per power of two), and the miss ratio is
+ *          the weighted misses over the weighted sample. (Normalizing by the
+ *          real access count instead, as SHARDS_adj does, is biased once the
+ *          rate has changed during the trace.)
+ *
+ *          Error bounds come from the sample itself: pages are split by
+ *          further hash bits into 16 disjoint groups, each a random page
+ *          sample of its own. The spread of the per-group miss ratios gives
+ *          the standard error, and the bound is twice that. Sizes below
+ *          1/R pages are not resolved by the sample and are the least
+ *          accurate.
+ */
+class ShardsAnalyzer {
+public:
+    static constexpr int kGroups = 16; ///< Page groups used for the error estimate.
+
+    /**
+     * @brief Create an empty sampler.
+     * @param maxPages    Most pages kept in the sample (the memory budget).
+     * @param initialRate Starting sampling rate in (0, 1]; it only decreases.
+     * @param pageShift   log2 of the page size used for address accesses.
+     * @throws std::invalid_argument if @p maxPages is 0 or the rate is out of range.
+     */
+    explicit ShardsAnalyzer(std::size_t maxPages = 8192, double initialRate = 1.0, int pageShift = 12);
+
+    /** @brief Record an access to a page key. */
+    void access(std::uint64_t key);
+
+    /** @brief Record one access. */
+    void add(const MemoryAccessEvent& ev) { access(sd_.keyOf(ev)); }
+
+    /** @brief Record a batch of accesses in order. */
+    void add(std::span<const MemoryAccessEvent> events) {
+        for (const auto& ev : events) access(sd_.keyOf(ev));
+    }
+
+    /**
+     * @brief Record every access of a trace source.
+     * @param source Stream of accesses (consumed).
+     * @param chunkSize Number of accesses pulled per batch.
+     * @return Number of accesses recorded.
+     */
+    std::size_t consume(TraceSource& source, std::size_t chunkSize = 4096);
+
+    /**
+     * @brief Estimated LRU miss ratio at the given memory sizes.
+     * @param frameCounts Memory sizes in pages.
+     * @return One point per entry of @p frameCounts, in the same order. While
+     *         the rate is still 1 the curve is exact up to bucket
+     *         interpolation and the error bound is 0.
+     */
+    std::vector<MissRatioPoint> missRatioCurve(std::span<const std::uint64_t> frameCounts) const;
+
+    /** @return Current sampling rate R. */
+    double samplingRate() const { return double(threshold_) / kHashRange; }
+    /** @return Number of accesses recorded. */
+    std::uint64_t accesses() const { return accesses_; }
+    /** @return Number of accesses that fell into the sample. */
+    std::uint64_t sampledAccesses() const { return sampled_; }
+    /** @return Number of pages currently in the sample. */
+    std::size_t samplePages() const { return heap_.size(); }
+    /** @return Estimated number of distinct pages in the trace. */
+    double estimatedPages() const;
+
+private:
+    static constexpr double kHashRange = 4294967296.0; ///< 2^32 sample hash values.
+    static constexpr int    kSubBuckets = 64;          ///< Buckets per power of two.
+
+    static std::size_t   bucketOf(double distance);
+    static std::uint64_t bucketBegin(std::size_t bucket);
+    void                 shrink();
+
+    StackDistanceAnalyzer sd_;
+    std::size_t           maxPages_;
+    std::uint64_t         threshold_;
+    /// Sampled pages by sample hash, largest on top.
+    std::priority_queue<std::pair<std::uint64_t, std::uint64_t>> heap_;
+    std::vector<double>   hist_;             ///< [bucket * kGroups + group] -> weight.
+    double                cold_[kGroups]{};  ///< Weighted first accesses per group.
+    std::uint64_t         accesses_{0};
+    std::uint64_t         sampled_{0};
+};
+
+#endif // ANALYSIS_SHARDS_H
@@ -0,0 +1,125 @@
+/**
+ * @file StackDistance.cpp
+ * @brief Implementation of the one-pass stack-distance analyzer.
+ */
+#include "analysis/StackDistance.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t kMinSlots = 1024; ///< Smallest time window of the tree.
+
+} // namespace
+
+StackDistanceAnalyzer::StackDistanceAnalyzer(int pageShift) : pageShift_(pageShift) {
+    if (pageShift < 9 || pageShift > 40) {
+        throw std::invalid_argument("StackDistanceAnalyzer: page shift must be in [9, 40]");
+    }
+    keyAt_.resize(kMinSlots);
+    tree_.assign(kMinSlots + 1, 0);
+    hist_.resize(2, 0);
+}
+
+void StackDistanceAnalyzer::treeAdd(std::size_t pos, int delta) {
+    for (std::size_t i = pos + 1; i < tree_.size(); i += i & (~i + 1)) {
+        tree_[i] = static_cast<std::uint32_t>(static_cast<int>(tree_[i]) + delta);
+    }
+}
+
+std::uint32_t StackDistanceAnalyzer::treePrefix(std::size_t pos) const {
+    std::uint32_t sum = 0;
+    for (std::size_t i = pos + 1; i > 0; i &= i - 1) sum += tree_[i];
+    return sum;
+}
+
+std::uint64_t StackDistanceAnalyzer::access(std::uint64_t key) {
+    if (now_ == keyAt_.size()) compact();
+    ++accesses_;
+
+    std::uint64_t distance = kCold;
+    auto [it, inserted] = last_.try_emplace(key, now_);
+    if (inserted) {
+        ++cold_;
+    } else {
+        // Pages whose last access is later than this page's are above it in the stack.
+        const std::uint64_t then  = it->second;
+        const std::uint64_t above = last_.size() - treePrefix(then);
+        distance = above + 1;
+        treeAdd(then, -1);
+        it->second = now_;
+        if (distance >= hist_.size()) hist_.resize(std::max<std::size_t>(distance + 1, hist_.size() * 2), 0);
+        ++hist_[distance];
+    }
+    keyAt_[now_] = key;
+    treeAdd(now_, +1);
+    ++now_;
+    return distance;
+}
+
+bool StackDistanceAnalyzer::erase(std::uint64_t key) {
+    auto it = last_.find(key);
+    if (it == last_.end()) return false;
+    treeAdd(it->second, -1);
+    last_.erase(it);
+    return true;
+}
+
+void StackDistanceAnalyzer::compact() {
+    // Renumber the live last-access times 0..M-1 in order and size the window
+    // so the next compaction is at least M accesses away.
+    const std::size_t live  = last_.size();
+    const std::size_t slots = std::max(kMinSlots, 2 * live);
+    std::vector<std::uint64_t> keys;
+    keys.reserve(slots);
+    for (std::uint64_t t = 0; t < now_; ++t) {
+        auto it = last_.find(keyAt_[t]);
+        if (it != last_.end() && it->second == t) {
+            it->second = keys.size();
+            keys.push_back(keyAt_[t]);
+        }
+    }
+    keys.resize(slots);
+    keyAt_.swap(keys);
+    now_ = live;
+
+    // Linear-time Fenwick build over the first `live` ones.
+    tree_.assign(slots + 1, 0);
+    for (std::size_t i = 1; i <= slots; ++i) {
+        if (i <= live) tree_[i] += 1;
+        const std::size_t parent = i + (i & (~i + 1));
+        if (parent <= slots) tree_[parent] += tree_[i];
+    }
+}
+
+std::size_t StackDistanceAnalyzer::consume(TraceSource& source, std::size_t chunkSize) {
+    if (chunkSize == 0) chunkSize = 1;
+    std::vector<MemoryAccessEvent> chunk;
+    chunk.reserve(chunkSize);
+    std::size_t total = 0;
+    while (source.next(chunk, chunkSize) > 0) {
+        add(chunk);
+        total += chunk.size();
+        chunk.clear();
+    }
+    return total;
+}
+
+std::vector<std::uint64_t> StackDistanceAnalyzer::faultCurve(std::uint64_t maxFrames) const {
+    // faults(f) = cold misses + accesses with distance > f (all accesses for f = 0).
+    std::vector<std::uint64_t> curve(maxFrames + 1);
+    std::uint64_t beyond = 0;
+    for (std::size_t d = hist_.size() - 1; d > maxFrames; --d) beyond += hist_[d];
+    for (std::uint64_t f = maxFrames + 1; f-- > 0;) {
+        curve[f] = coldMisses() + beyond;
+        if (f < hist_.size()) beyond += hist_[f];
+    }
+    return curve;
+}
+
+std::uint64_t StackDistanceAnalyzer::faults(std::uint64_t frames) const {
+    std::uint64_t n = coldMisses();
+    for (std::size_t d = frames + 1; d < hist_.size(); ++d) n += hist_[d];
+    return n;
+}
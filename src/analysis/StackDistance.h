@@ -0,0 +1,127 @@
+/**
+ * @file StackDistance.h
+ * @brief One-pass LRU stack-distance analysis (Mattson) with a Fenwick tree.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * StackDistanceAnalyzer sd;
+ * auto source = openTrace("trace.bin");
+ * sd.consume(*source);
+ * auto faults = sd.faultCurve(4096); // faults[f] = LRU page faults with f frames
+ * @endcode
+ */
+#ifndef ANALYSIS_STACKDISTANCE_H
+#define ANALYSIS_STACKDISTANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "core/MemoryAccessEvent.h"
+#include "trace/TraceSource.h"
+
+/**
+ * @brief Computes the LRU stack distance of every access in a single pass.
+ * @details The stack distance of an access is the number of distinct pages
+ *          referenced since the previous access to the same page, plus one;
+ *          an LRU memory of F frames hits exactly when it is <= F. The
+ *          analyzer keeps each page's last access time and a Fenwick tree
+ *          over time with a 1 at every page's last access, so the distance is
+ *          a suffix count: O(log M) per access for M distinct pages. Times
+ *          are renumbered when the tree fills up, so memory stays O(M)
+ *          however long the trace is.
+ *
+ *          The histogram gives the exact fault count of Simulation with
+ *          @ref LRUAlgorithm for every frame count at once. Since a fully
+ *          associative LRU TLB follows the same stack, the curve is also the
+ *          TLB miss curve for every TLB capacity up to the frame count.
+ *
+ *          Accesses of different processes are distinct pages. Address
+ *          accesses are split into pages of 2^pageShift bytes.
+ */
+class StackDistanceAnalyzer {
+public:
+    /// Distance reported for the first access to a page (a cold miss).
+    static constexpr std::uint64_t kCold = 0;
+
+    /**
+     * @brief Create an empty analyzer.
+     * @param pageShift log2 of the page size used for address accesses.
+     */
+    explicit StackDistanceAnalyzer(int pageShift = 12);
+
+    /**
+     * @brief Record an access to a page key.
+     * @param key Any 64-bit page identifier.
+     * @return Stack distance (>= 1), or kCold for a first access.
+     */
+    std::uint64_t access(std::uint64_t key);
+
+    /**
+     * @brief Forget a page, as if it had never been accessed.
+     * @details Distances of later accesses no longer count it; its next access
+     *          is a cold miss again. Used by samplers that drop pages.
+     * @return True if the page was tracked.
+     */
+    bool erase(std::uint64_t key);
+
+    /** @brief Record one access. */
+    std::uint64_t add(const MemoryAccessEvent& ev) { return access(keyOf(ev)); }
+
+    /** @brief Record a batch of accesses in order. */
+    void add(std::span<const MemoryAccessEvent> events) {
+        for (const auto& ev : events) access(keyOf(ev));
+    }
+
+    /**
+     * @brief Record every access of a trace source.
+     * @param source Stream of accesses (consumed).
+     * @param chunkSize Number of accesses pulled per batch.
+     * @return Number of accesses recorded.
+     */
+    std::size_t consume(TraceSource& source, std::size_t chunkSize = 4096);
+
+    /**
+     * @brief LRU faults for every frame count from 0 to @p maxFrames.
+     * @return Vector f -> faults with f frames (f = 0 counts every access).
+     */
+    std::vector<std::uint64_t> faultCurve(std::uint64_t maxFrames) const;
+
+    /** @return LRU faults with @p frames frames (O(M); use faultCurve for many). */
+    std::uint64_t faults(std::uint64_t frames) const;
+
+    /** @return hist[d] = number of accesses with stack distance d (hist[0] unused). */
+    const std::vector<std::uint64_t>& histogram() const { return hist_; }
+
+    /** @return Number of accesses recorded. */
+    std::uint64_t accesses() const { return accesses_; }
+    /** @return Number of first accesses (faults with unlimited frames). */
+    std::uint64_t coldMisses() const { return cold_; }
+    /** @return Number of distinct pages tracked (seen and not erased). */
+    std::uint64_t distinctPages() const { return last_.size(); }
+
+    /** @return Page key of an access: process ID plus page ID or address page. */
+    std::uint64_t keyOf(const MemoryAccessEvent& ev) const {
+        const std::uint64_t pid = std::uint64_t{ev.processId()} << 55;
+        if (ev.isAddress()) return (std::uint64_t{1} << 63) | pid | (ev.address() >> pageShift_);
+        return pid | static_cast<std::uint32_t>(ev.pageId());
+    }
+
+private:
+    void compact();
+    void treeAdd(std::size_t pos, int delta);
+    std::uint32_t treePrefix(std::size_t pos) const; ///< Ones at times <= pos.
+
+    int                                              pageShift_;
+    std::unordered_map<std::uint64_t, std::uint64_t> last_;   ///< Page key -> time of last access.
+    std::vector<std::uint64_t>                       keyAt_;  ///< Time -> page key accessed then.
+    std::vector<std::uint32_t>                       tree_;   ///< Fenwick tree over times (1-based).
+    std::uint64_t                                    now_{0}; ///< Next time slot.
+    std::vector<std::uint64_t>                       hist_;
+    std::uint64_t                                    accesses_{0};
+    std::uint64_t                                    cold_{0};
+};
+
+#endif // ANALYSIS_STACKDISTANCE_H
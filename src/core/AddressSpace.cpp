@@ -0,0 +1,79 @@
+/**
+ * @file AddressSpace.cpp
+ * @brief Implementation of virtual-address translation.
+ */
+#include "core/AddressSpace.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+AddressSpace::AddressSpace(std::uint64_t pageBytes) {
+    if (pageBytes != 4096 && pageBytes != 16384 && pageBytes != 65536) {
+        throw std::invalid_argument("AddressSpace: page size must be 4, 16 or 64 KiB, got "
+                                    + std::to_string(pageBytes));
+    }
+    pageShift_ = std::countr_zero(pageBytes);
+}
+
+void AddressSpace::mapHuge(std::uint64_t base, std::uint64_t length, PageSize size) {
+    if (size == PageSize::Base) {
+        throw std::invalid_argument("AddressSpace: mapHuge needs a huge page size");
+    }
+    const std::uint64_t mask = bytesOf(size) - 1;
+    if (length == 0 || (base & mask) != 0 || (length & mask) != 0 || base + length < base) {
+        throw std::invalid_argument("AddressSpace: huge range must be non-empty and aligned to "
+                                    + std::to_string(bytesOf(size)) + " bytes");
+    }
+    const Region r{base, base + length, size};
+    auto it = std::upper_bound(regions_.begin(), regions_.end(), r.begin,
+                               [](std::uint64_t a, const Region& x) { return a < x.begin; });
+    if ((it != regions_.end() && it->begin < r.end)
+        || (it != regions_.begin() && std::prev(it)->end > r.begin)) {
+        throw std::invalid_argument("AddressSpace: huge ranges must not overlap");
+    }
+    regions_.insert(it, r);
+}
+
+PageSize AddressSpace::sizeAt(std::uint64_t address) const {
+    auto it = std::upper_bound(regions_.begin(), regions_.end(), address,
+                               [](std::uint64_t a, const Region& x) { return a < x.begin; });
+    if (it == regions_.begin()) return PageSize::Base;
+    --it;
+    return address < it->end ? it->size : PageSize::Base;
+}
+
+int AddressSpace::translate(std::uint64_t address) {
+    const PageSize      size = regions_.empty() ? PageSize::Base : sizeAt(address);
+    const std::uint64_t vpn  = address >> shiftOf(size);
+    const std::uint64_t key  = (std::uint64_t{static_cast<unsigned char>(size)} << kSizeShift)
+                             | (vpn >> kGroupBits);
+
+    // Consecutive accesses mostly stay within one group.
+    if (key != lastKey_) {
+        auto [it, inserted] = groups_.try_emplace(key, static_cast<std::uint32_t>(groupKeys_.size()));
+        if (inserted) {
+            if (groupKeys_.size() == kMaxGroups) {
+                groups_.erase(it);
+                return -1;
+            }
+            groupKeys_.push_back(key);
+        }
+        lastKey_   = key;
+        lastGroup_ = it->second;
+    }
+    const std::uint64_t low = vpn & ((std::uint64_t{1} << kGroupBits) - 1);
+    return static_cast<int>((std::uint64_t{lastGroup_} << kGroupBits) | low);
+}
+
+std::uint64_t AddressSpace::addressOf(int pageId) const {
+    const PageSize      size  = pageSize(pageId);
+    const auto          group = static_cast<std::size_t>(pageId) >> kGroupBits;
+    if (pageId < 0 || group >= groupKeys_.size()) return 0;
+    const std::uint64_t groupVpn = groupKeys_[group] & ((std::uint64_t{1} << kSizeShift) - 1);
+    const std::uint64_t vpn = (groupVpn << kGroupBits)
+                            | (static_cast<std::uint64_t>(pageId) & ((std::uint64_t{1} << kGroupBits) - 1));
+    return vpn << shiftOf(size);
+}
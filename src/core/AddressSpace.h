@@ -0,0 +1,114 @@
+/**
+ * @file AddressSpace.h
+ * @brief Virtual-address translation of a process: base page size and huge-page mappings.
+ */
+#ifndef CORE_ADDRESSSPACE_H
+#define CORE_ADDRESSSPACE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/** @brief Size class of a mapping. */
+enum class PageSize : unsigned char {
+    Base,   ///< The address space's base page (4, 16 or 64 KiB).
+    Huge2M, ///< 2 MiB huge page.
+    Huge1G  ///< 1 GiB huge page.
+};
+
+/**
+ * @brief Turns 64-bit virtual addresses into the simulator's int page IDs.
+ * @details Addresses inside a region registered with @ref mapHuge belong to
+ *          a 2 MiB or 1 GiB page, all others to a base page. Page IDs are
+ *          handed out on first touch: the virtual page numbers of each size
+ *          are split into groups of 512 (one leaf page-table node) and every
+ *          group touched gets the next group number, so
+ *          page ID = group number * 512 + (VPN mod 512).
+ *          IDs therefore stay compact for the paging algorithms and page
+ *          tables, while the low 9 VPN bits that select the TLB set are
+ *          kept. Different page sizes never share a group, so a huge page
+ *          has a page ID (and TLB entries) of its own.
+ */
+class AddressSpace {
+public:
+    static constexpr std::uint64_t kDefaultPageBytes = 4096;
+    static constexpr std::uint64_t kHuge2MBytes      = std::uint64_t{1} << 21;
+    static constexpr std::uint64_t kHuge1GBytes      = std::uint64_t{1} << 30;
+    static constexpr int           kGroupBits        = 9;  ///< VPN bits kept in the page ID.
+
+    /**
+     * @brief Address space with a given base page size.
+     * @param pageBytes 4096, 16384 or 65536.
+     * @throws std::invalid_argument for other sizes.
+     */
+    explicit AddressSpace(std::uint64_t pageBytes = kDefaultPageBytes);
+
+    /**
+     * @brief Back a virtual range with huge pages.
+     * @param base   Start address, aligned to the huge page size.
+     * @param length Length in bytes, a multiple of the huge page size.
+     * @param size   PageSize::Huge2M or PageSize::Huge1G.
+     * @throws std::invalid_argument if the range is misaligned, empty,
+     *         overlaps another huge range or @p size is not a huge size.
+     */
+    void mapHuge(std::uint64_t base, std::uint64_t length, PageSize size);
+
+    /**
+     * @brief Page ID of the page containing @p address (assigned on first touch).
+     * @return Page ID, or -1 once the int page-ID space is exhausted.
+     */
+    int translate(std::uint64_t address);
+
+    /** @return Size class of a page ID (PageSize::Base for IDs never handed out). */
+    PageSize pageSize(int pageId) const {
+        const auto group = static_cast<std::size_t>(pageId) >> kGroupBits;
+        return pageId >= 0 && group < groupKeys_.size()
+                 ? static_cast<PageSize>(groupKeys_[group] >> kSizeShift) : PageSize::Base;
+    }
+
+    /** @return Virtual start address of a page ID handed out by @ref translate. */
+    std::uint64_t addressOf(int pageId) const;
+
+    /** @return Base page size in bytes. */
+    std::uint64_t pageBytes() const { return std::uint64_t{1} << pageShift_; }
+    /** @return Bytes covered by a page of size class @p size. */
+    std::uint64_t bytesOf(PageSize size) const { return std::uint64_t{1} << shiftOf(size); }
+    /** @return Bytes covered by the page with ID @p pageId. */
+    std::uint64_t bytesOf(int pageId) const { return bytesOf(pageSize(pageId)); }
+    /** @return Number of base-page frames a page of size class @p size occupies. */
+    std::uint64_t framesPerPage(PageSize size) const { return bytesOf(size) >> pageShift_; }
+
+    /** @brief A virtual range registered with @ref mapHuge. */
+    struct Region {
+        std::uint64_t begin; ///< First address.
+        std::uint64_t end;   ///< One past the last address.
+        PageSize      size;  ///< Huge page size backing the range.
+    };
+
+    /** @return True if any huge range is mapped. */
+    bool hasHugeMappings() const { return !regions_.empty(); }
+    /** @return Huge ranges, sorted by begin. */
+    const std::vector<Region>& hugeRegions() const { return regions_; }
+
+private:
+    static constexpr int           kSizeShift = 62; ///< Size class in the top bits of a group key.
+    static constexpr std::uint32_t kMaxGroups = std::uint32_t{1} << (31 - kGroupBits);
+
+    int shiftOf(PageSize size) const {
+        switch (size) {
+        case PageSize::Huge2M: return 21;
+        case PageSize::Huge1G: return 30;
+        default:               return pageShift_;
+        }
+    }
+    PageSize sizeAt(std::uint64_t address) const;
+
+    int                                              pageShift_;
+    std::vector<Region>                              regions_;   ///< Huge ranges, sorted by begin.
+    std::unordered_map<std::uint64_t, std::uint32_t> groups_;    ///< Group key -> group number.
+    std::vector<std::uint64_t>                       groupKeys_; ///< Group number -> group key.
+    std::uint64_t                                    lastKey_{~std::uint64_t{0}}; ///< One-entry lookup cache.
+    std::uint32_t                                    lastGroup_{0};
+};
+
+#endif // CORE_ADDRESSSPACE_H
@@ -0,0 +1,89 @@
+/**
+* @file ClockAlgorithm.cpp
+ * @brief Implementation of CLOCK replacement.
+ */
+#include "core/algorithms/ClockAlgorithm.h"
+
+
+void ClockAlgorithm::setRef(std::size_t pos, bool on) {
+    const Word bit = Word{1} << (pos % 64);
+    if (on) ref[pos / 64] |= bit; else ref[pos / 64] &= ~bit;
+}
+
+void ClockAlgorithm::moveSlot(std::size_t from, std::size_t to) {
+    slotFrame[to] = slotFrame[from];
+    slotPage[to]  = slotPage[from];
+    setRef(to, testRef(from));
+    if (slotPage[to] != -1) pagePos[slotPage[to]] = static_cast<int>(to);
+}
+
+void ClockAlgorithm::insertBeforeHand(int pageId, int frameIndex) {
+    // Only while memory is still filling up: the list back is the position
+    // just before the hand, i.e. the array end if the hand is at 0.
+    const std::size_t n = slotFrame.size();
+    if (n % 64 == 0) ref.push_back(0);
+    slotFrame.push_back(-1);
+    slotPage.push_back(-1);
+
+    std::size_t pos = n;
+    if (hand != 0) {
+        for (std::size_t p = n; p > hand; --p) moveSlot(p - 1, p);
+        pos = hand++;
+    }
+    slotFrame[pos] = frameIndex;
+    slotPage[pos]  = pageId;
+    setRef(pos, true); // Newly loaded page is referenced once.
+    pagePos[pageId] = static_cast<int>(pos);
+}
+
+void ClockAlgorithm::removeVacant() {
+    // Two evictions without a load in between (or an explicit unload): drop
+    // the empty slot so the sweep never lands on it (the list version simply
+    // has no node there).
+    const auto v = static_cast<std::size_t>(vacant);
+    const std::size_t n = slotFrame.size();
+    for (std::size_t p = v + 1; p < n; ++p) moveSlot(p, p - 1);
+    setRef(n - 1, false);
+    slotFrame.pop_back();
+    slotPage.pop_back();
+    if ((n - 1) % 64 == 0) ref.pop_back();
+    if (hand > v) --hand;
+    if (hand >= slotFrame.size()) hand = 0;
+    vacant = -1;
+}
+
+void ClockAlgorithm::pageLoaded(int pageId, int frameIndex) {
+    if (pageId < 0 || frameIndex < 0) return;
+    if (pageId >= static_cast<int>(pagePos.size())) pagePos.resize(pageId + 1, -1);
+    if (pagePos[pageId] != -1) return; // already resident
+
+    if (vacant != -1) {
+        const auto pos = static_cast<std::size_t>(vacant);
+        slotFrame[pos] = frameIndex;
+        slotPage[pos]  = pageId;
+        setRef(pos, true); // Newly loaded page is referenced once.
+        pagePos[pageId] = static_cast<int>(pos);
+        vacant = -1;
+    } else {
+        insertBeforeHand(pageId, frameIndex);
+    }
+    ++resident;
+}
+
+void ClockAlgorithm::pageUnloaded(int pageId, int /*frameIndex*/) {
+    if (pageId < 0 || pageId >= static_cast<int>(pagePos.size())) return;
+    if (pagePos[pageId] == -1) return;
+    if (vacant != -1) removeVacant(); // may shift positions
+
+    const int pos = pagePos[pageId];
+    pagePos[pageId] = -1;
+    slotPage[pos] = -1;
+    vacant = pos;
+    removeVacant();
+    --resident;
+}
+
+std::size_t ClockAlgorithm::footprintBytes() const {
+    return (slotFrame.capacity() + slotPage.capacity() + pagePos.capacity()) * sizeof(int)
+         + ref.capacity() * sizeof(Word);
+}
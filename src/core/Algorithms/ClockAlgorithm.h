@@ -0,0 +1,97 @@
+/**
+* @file ClockAlgorithm.h
+ * @brief CLOCK page replacement: array-backed Second-Chance.
+ */
+#ifndef CORE_ALGORITHMS_CLOCKALGORITHM_H
+#define CORE_ALGORITHMS_CLOCKALGORITHM_H
+
+#include "core/PagingAlgorithm.h"
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+/**
+ * @brief CLOCK: frames on a circular array with a hand and packed R bits.
+ * @details Produces the same victims as @ref SecondChanceAlgorithm: clock
+ *          position order equals the order of its list, the hand is the list
+ *          front, and a page loaded after an eviction takes the victim's slot
+ *          (directly behind the hand, i.e. the list back). Giving a page its
+ *          second chance only clears a bit; runs of referenced frames are
+ *          skipped 64 at a time. No allocation or hashing after warm-up.
+ */
+class ClockAlgorithm final : public PagingAlgorithm {
+public:
+    ClockAlgorithm() = default;
+    ~ClockAlgorithm() override = default;
+
+    void memoryAccess(int pageId) override;
+    int  selectVictimPage() override;
+    void pageLoaded(int pageId, int frameIndex) override;
+    void pageUnloaded(int pageId, int frameIndex) override;
+    std::size_t footprintBytes() const override;
+
+private:
+    using Word = std::uint64_t;
+
+    bool testRef(std::size_t pos) const { return (ref[pos / 64] >> (pos % 64)) & 1u; }
+    void setRef(std::size_t pos, bool on);
+    void moveSlot(std::size_t from, std::size_t to);
+    void insertBeforeHand(int pageId, int frameIndex);
+    void removeVacant();
+
+    std::vector<int>  slotFrame; ///< clock position -> frame.
+    std::vector<int>  slotPage;  ///< clock position -> page (-1 if vacant).
+    std::vector<Word> ref;       ///< Packed R bits by clock position.
+    std::vector<int>  pagePos;   ///< pageId -> clock position (-1 if not resident).
+    std::size_t       hand{0};   ///< Next position to inspect.
+    long              vacant{-1}; ///< Position freed by the last eviction, or -1.
+    std::size_t       resident{0};
+};
+
+// Per-access and per-eviction hooks, defined here so BasicSimulation<ClockAlgorithm> can inline them.
+
+inline void ClockAlgorithm::memoryAccess(int pageId) {
+    if (pageId < 0 || pageId >= static_cast<int>(pagePos.size())) return;
+    const int pos = pagePos[pageId];
+    if (pos != -1) ref[pos / 64] |= Word{1} << (pos % 64);
+}
+
+inline int ClockAlgorithm::selectVictimPage() {
+    if (resident == 0) throw std::logic_error("Clock: empty clock");
+
+    if (vacant != -1) removeVacant();
+
+    const std::size_t n = slotFrame.size();
+    std::size_t pos = hand;
+    std::size_t victim;
+    // Sweep for the first clear R bit, clearing the set ones on the way.
+    // Terminates within one turn plus one word: every passed bit is cleared.
+    while (true) {
+        const std::size_t w = pos / 64;
+        const std::size_t b = pos % 64;
+        const std::size_t wordEnd = (w + 1) * 64;
+        const Word inRange = (wordEnd <= n) ? ~Word{0} : ((Word{1} << (n % 64)) - 1);
+        const Word fromPos = inRange & (~Word{0} << b);
+
+        const Word candidates = ~ref[w] & fromPos;
+        if (candidates) {
+            victim = w * 64 + std::countr_zero(candidates);
+            const Word passed = fromPos & ((Word{1} << (victim % 64)) - 1);
+            ref[w] &= ~passed;
+            break;
+        }
+        ref[w] &= ~fromPos;
+        pos = (wordEnd >= n) ? 0 : wordEnd;
+    }
+
+    const int frame = slotFrame[victim];
+    pagePos[slotPage[victim]] = -1;
+    slotPage[victim] = -1;
+    vacant = static_cast<long>(victim);
+    hand = (victim + 1 == n) ? 0 : victim + 1;
+    --resident;
+    return frame;
+}
+
+#endif // CORE_ALGORITHMS_CLOCKALGORITHM_H
@@ -4,17 +4,13 @@
  * @brief Implementation of FIFO page replacement.
  */
 #include "core/algorithms/FIFOAlgorithm.h"
-#include <stdexcept>
+#include <algorithm>
 
-int FIFOAlgorithm::selectVictimPage() {
-    if (frameQueue.empty()) {
-        throw std::logic_error("FIFO: empty queue");
-    }
-    int victim = frameQueue.front();
-    frameQueue.pop();
-    return victim;
+void FIFOAlgorithm::pageUnloaded(int /*pageId*/, int frameIndex) {
+    auto it = std::find(frameQueue.begin(), frameQueue.end(), frameIndex);
+    if (it != frameQueue.end()) frameQueue.erase(it);
 }
 
-void FIFOAlgorithm::pageLoaded(int /*pageId*/, int frameIndex) {
-    frameQueue.push(frameIndex);
+std::size_t FIFOAlgorithm::footprintBytes() const {
+    return frameQueue.size() * sizeof(int);
 }
@@ -6,13 +6,13 @@
 #define CORE_ALGORITHMS_FIFOALGORITHM_H
 
 #include "core/PagingAlgorithm.h"
-#include <queue>
+#include <deque>
 #include <stdexcept>
 
 /**
  * @brief FIFO replacement: evict the frame that was filled earliest.
  */
-class FIFOAlgorithm : public PagingAlgorithm {
+class FIFOAlgorithm final : public PagingAlgorithm {
 public:
     FIFOAlgorithm() = default;
     ~FIFOAlgorithm() override = default;
@@ -20,9 +20,26 @@ public:
     void memoryAccess(int /*pageId*/) override {}
     int  selectVictimPage() override;
     void pageLoaded(int /*pageId*/, int frameIndex) override;
+    void pageUnloaded(int /*pageId*/, int frameIndex) override;
+    std::size_t footprintBytes() const override;
 
 private:
-    std::queue<int> frameQueue; ///< Queue of frames in loading order.
+    std::deque<int> frameQueue; ///< Queue of frames in loading order.
 };
 
+// Per-fault hooks, defined here so BasicSimulation<FIFOAlgorithm> can inline them.
+
+inline int FIFOAlgorithm::selectVictimPage() {
+    if (frameQueue.empty()) {
+        throw std::logic_error("FIFO: empty queue");
+    }
+    int victim = frameQueue.front();
+    frameQueue.pop_front();
+    return victim;
+}
+
+inline void FIFOAlgorithm::pageLoaded(int /*pageId*/, int frameIndex) {
+    frameQueue.push_back(frameIndex);
+}
+
 #endif // CORE_ALGORITHMS_FIFOALGORITHM_H
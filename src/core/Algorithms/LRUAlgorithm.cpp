@@ -3,34 +3,39 @@
  * @brief Implementation of LRU page replacement.
  */
 #include "core/algorithms/LRUAlgorithm.h"
-#include <stdexcept>
-#include <limits>
 
-LRUAlgorithm::LRUAlgorithm() : accessCounter(0) {}
+LRUAlgorithm::LRUAlgorithm() = default;
 
-void LRUAlgorithm::memoryAccess(int pageId) {
-    ++accessCounter;
-    auto it = table.find(pageId);
-    if (it != table.end()) it->second.lastUse = accessCounter;
-}
+void LRUAlgorithm::pageLoaded(int pageId, int frameIndex) {
+    if (pageId < 0 || frameIndex < 0) return;
+    if (frameIndex >= static_cast<int>(frames.size())) frames.resize(frameIndex + 1);
+    if (pageId >= static_cast<int>(pageFrame.size())) pageFrame.resize(pageId + 1, -1);
 
-int LRUAlgorithm::selectVictimPage() {
-    if (table.empty()) throw std::logic_error("LRU: empty table");
-    long oldest = std::numeric_limits<long>::max();
-    int victimFrame = -1;
-    int victimPage  = -1;
-    for (auto &kv : table) {
-        if (kv.second.lastUse < oldest) {
-            oldest = kv.second.lastUse;
-            victimFrame = kv.second.frameIndex;
-            victimPage = kv.first;
-        }
+    // Re-loading a tracked page or reusing a tracked frame replaces the old entry.
+    if (pageFrame[pageId] != -1) {
+        const int old = pageFrame[pageId];
+        unlink(old);
+        frames[old].pageId = -1;
     }
-    if (victimPage != -1) table.erase(victimPage);
-    return victimFrame;
+    if (frames[frameIndex].pageId != -1) {
+        unlink(frameIndex);
+        pageFrame[frames[frameIndex].pageId] = -1;
+    }
+
+    frames[frameIndex].pageId = pageId;
+    pageFrame[pageId] = frameIndex;
+    pushFront(frameIndex);
 }
 
-void LRUAlgorithm::pageLoaded(int pageId, int frameIndex) {
-    ++accessCounter;
-    table[pageId] = Info{frameIndex, accessCounter};
+void LRUAlgorithm::pageUnloaded(int pageId, int /*frameIndex*/) {
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    const int frame = pageFrame[pageId];
+    if (frame == -1) return;
+    unlink(frame);
+    frames[frame].pageId = -1;
+    pageFrame[pageId] = -1;
+}
+
+std::size_t LRUAlgorithm::footprintBytes() const {
+    return frames.capacity() * sizeof(Node) + pageFrame.capacity() * sizeof(int);
 }
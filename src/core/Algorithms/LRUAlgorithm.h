@@ -6,12 +6,18 @@
 #define CORE_ALGORITHMS_LRUALGORITHM_H
 
 #include "core/PagingAlgorithm.h"
-#include <unordered_map>
+#include <stdexcept>
+#include <vector>
 
 /**
- * @brief LRU replacement based on a logical access counter.
+ * @brief LRU replacement with O(1) access, load and eviction.
+ * @details Resident pages form an intrusive doubly linked recency list whose
+ *          nodes live in a flat array indexed by frame (head = most recently
+ *          used, tail = victim). A second flat array maps page IDs to frames,
+ *          so the hot path does no hashing and no allocation once both arrays
+ *          have grown to the working size.
  */
-class LRUAlgorithm : public PagingAlgorithm {
+class LRUAlgorithm final : public PagingAlgorithm {
 public:
     LRUAlgorithm();
     ~LRUAlgorithm() override = default;
@@ -19,11 +25,57 @@ public:
     void memoryAccess(int pageId) override;
     int  selectVictimPage() override;
     void pageLoaded(int pageId, int frameIndex) override;
+    void pageUnloaded(int pageId, int frameIndex) override;
+    std::size_t footprintBytes() const override;
 
 private:
-    long accessCounter; ///< Monotonic counter incremented on each access.
-    struct Info { int frameIndex; long lastUse; };
-    std::unordered_map<int, Info> table; ///< pageId -> Info
+    struct Node {
+        int pageId{-1}; ///< Resident page (-1 if the frame is not tracked).
+        int prev{-1};   ///< More recently used frame (-1 at head).
+        int next{-1};   ///< Less recently used frame (-1 at tail).
+    };
+
+    void unlink(int frame);
+    void pushFront(int frame);
+
+    std::vector<Node> frames;    ///< frameIndex -> recency list node.
+    std::vector<int>  pageFrame; ///< pageId -> frameIndex (-1 if not resident).
+    int head{-1};                ///< Most recently used frame.
+    int tail{-1};                ///< Least recently used frame.
 };
 
+// Per-access and per-eviction hooks, defined here so BasicSimulation<LRUAlgorithm> can inline them.
+
+inline void LRUAlgorithm::unlink(int frame) {
+    Node& n = frames[frame];
+    if (n.prev != -1) frames[n.prev].next = n.next; else head = n.next;
+    if (n.next != -1) frames[n.next].prev = n.prev; else tail = n.prev;
+    n.prev = n.next = -1;
+}
+
+inline void LRUAlgorithm::pushFront(int frame) {
+    Node& n = frames[frame];
+    n.prev = -1;
+    n.next = head;
+    if (head != -1) frames[head].prev = frame; else tail = frame;
+    head = frame;
+}
+
+inline void LRUAlgorithm::memoryAccess(int pageId) {
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    const int frame = pageFrame[pageId];
+    if (frame == -1 || frame == head) return;
+    unlink(frame);
+    pushFront(frame);
+}
+
+inline int LRUAlgorithm::selectVictimPage() {
+    if (tail == -1) throw std::logic_error("LRU: empty table");
+    const int victimFrame = tail;
+    unlink(victimFrame);
+    pageFrame[frames[victimFrame].pageId] = -1;
+    frames[victimFrame].pageId = -1;
+    return victimFrame;
+}
+
 #endif // CORE_ALGORITHMS_LRUALGORITHM_H
@@ -4,43 +4,83 @@
  */
 #include "core/algorithms/NFUAlgorithm.h"
 
-void NFUAlgorithm::memoryAccess(int pageId) {
-    auto it = table.find(pageId);
-    if (it != table.end()) {
-        it->second.referenced = true; // mark referenced; age injection happens on aging step
-    }
-}
+NFUAlgorithm::NFUAlgorithm(nfu::Kernel kernel) : kernels(&nfu::kernels(kernel)) {}
 
 int NFUAlgorithm::selectVictimPage() {
-    if (table.empty()) throw std::logic_error("NFU(aging): empty table");
+    if (resident == 0) throw std::logic_error("NFU(aging): empty table");
 
-    // Aging step: shift right and inject R into MSB, then clear R
-    for (auto &kv : table) {
-        auto &inf = kv.second;
-        inf.age = static_cast<uint8_t>((inf.age >> 1) | (inf.referenced ? 0x80 : 0x00));
-        inf.referenced = false;
-    }
+    // Aging step: shift right and inject R into MSB, then clear R.
+    // Empty frames are forced back to 0xFF so they never become the minimum.
+    const std::uint8_t minAge = kernels->ageAndMin(age.data(), ref.data(), invalid.data(), age.size());
 
-    // Pick the coldest (smallest age). Tie-breaking by first minimum encountered.
-    uint8_t minAge = std::numeric_limits<uint8_t>::max();
-    int victimPage  = -1;
-    int victimFrame = -1;
-    for (const auto &kv : table) {
-        const auto &inf = kv.second;
-        if (inf.age < minAge) {
-            minAge = inf.age;
-            victimPage  = kv.first;
-            victimFrame = inf.frameIndex;
-        }
+    // Pick the coldest (smallest age). Tie-breaking by first minimum in frame order.
+    std::size_t victim = kernels->findFirst(age.data(), age.size(), minAge);
+    if (minAge == 0xFF) {
+        // All resident pages are at 0xFF, like the empty frames: take the first resident one.
+        victim = 0;
+        while (invalid[victim]) ++victim;
     }
 
-    if (victimPage != -1) table.erase(victimPage);
+    const int victimFrame = static_cast<int>(victim);
+    pageFrame[framePage[victimFrame]] = -1;
+    framePage[victimFrame] = -1;
+    invalid[victimFrame]   = 0xFF;
+    age[victimFrame]       = 0xFF;
+    --resident;
     return victimFrame;
 }
 
+void NFUAlgorithm::growFrames(int frameIndex) {
+    // Keep the arrays a multiple of the SIMD width; padding slots are empty frames.
+    std::size_t n = static_cast<std::size_t>(frameIndex) + 1;
+    n = (n + nfu::kLaneBytes - 1) / nfu::kLaneBytes * nfu::kLaneBytes;
+    age.resize(n, 0xFF);
+    ref.resize(n, 0);
+    invalid.resize(n, 0xFF);
+    framePage.resize(n, -1);
+}
+
 void NFUAlgorithm::pageLoaded(int pageId, int frameIndex) {
+    if (pageId < 0 || frameIndex < 0) return;
+    if (frameIndex >= static_cast<int>(age.size())) growFrames(frameIndex);
+    if (pageId >= static_cast<int>(pageFrame.size())) pageFrame.resize(pageId + 1, -1);
+
+    // Re-loading a tracked page or reusing a tracked frame replaces the old entry.
+    if (pageFrame[pageId] != -1) {
+        const int old = pageFrame[pageId];
+        framePage[old] = -1;
+        invalid[old] = age[old] = 0xFF;
+        ref[old] = 0;
+        --resident;
+    }
+    if (framePage[frameIndex] != -1) {
+        pageFrame[framePage[frameIndex]] = -1;
+        --resident;
+    }
+
     // Fresh page starts cold (age=0). Since the faulting access is the first access,
     // we mark referenced=true; Simulation will also call memoryAccess() on the same step,
     // which keeps referenced=true and will lead to MSB injection on the next aging.
-    table[pageId] = Info{frameIndex, /*age*/0u, /*referenced*/true};
+    framePage[frameIndex] = pageId;
+    pageFrame[pageId]     = frameIndex;
+    age[frameIndex]       = 0;
+    ref[frameIndex]       = 0x80;
+    invalid[frameIndex]   = 0;
+    ++resident;
+}
+
+void NFUAlgorithm::pageUnloaded(int pageId, int /*frameIndex*/) {
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    const int frame = pageFrame[pageId];
+    if (frame == -1) return;
+    pageFrame[pageId] = -1;
+    framePage[frame]  = -1;
+    invalid[frame] = age[frame] = 0xFF;
+    ref[frame] = 0;
+    --resident;
+}
+
+std::size_t NFUAlgorithm::footprintBytes() const {
+    return age.capacity() + ref.capacity() + invalid.capacity()
+         + (framePage.capacity() + pageFrame.capacity()) * sizeof(int);
 }
@@ -6,10 +6,10 @@
 #define CORE_ALGORITHMS_NFUALGORITHM_H
 
 #include "core/PagingAlgorithm.h"
-#include <unordered_map>
+#include "core/algorithms/NFUKernels.h"
+#include <vector>
 #include <cstdint>
 #include <stdexcept>
-#include <limits>
 
 /**
  * @brief NFU with classical aging.
@@ -17,11 +17,19 @@
  *          On each replacement decision (or periodically if extended), all ages are updated:
  *              age = (age >> 1) | (referenced ? 0x80 : 0x00);
  *              referenced = false;
- *          Victim is the page with the smallest age (coldest).
+ *          Victim is the page with the smallest age (coldest); ties go to the lowest frame.
+ *
+ *          Ages and R flags are stored as frame-indexed byte arrays (structure of
+ *          arrays), so aging and the argmin run as SIMD kernels (AVX2/SSE2 with a
+ *          scalar fallback, chosen at runtime, see @ref nfu::kernels).
  */
-class NFUAlgorithm : public PagingAlgorithm {
+class NFUAlgorithm final : public PagingAlgorithm {
 public:
-  NFUAlgorithm() = default;
+  /**
+   * @brief Construct the policy.
+   * @param kernel Kernel set for aging/argmin; Auto picks the best supported one.
+   */
+  explicit NFUAlgorithm(nfu::Kernel kernel = nfu::Kernel::Auto);
   ~NFUAlgorithm() override = default;
 
   /** @brief Mark page as referenced for this access. */
@@ -37,13 +45,35 @@ public:
   /** @brief Register a freshly loaded page with age=0 and referenced=true (first access). */
   void pageLoaded(int pageId, int frameIndex) override;
 
+  /** @brief Forget a page removed without eviction; its frame becomes empty. */
+  void pageUnloaded(int pageId, int frameIndex) override;
+
+  /** @return Bytes of the per-frame and per-page tables. */
+  std::size_t footprintBytes() const override;
+
+  /** @return Name of the kernel set in use ("scalar", "sse2" or "avx2"). */
+  const char* kernelName() const { return kernels->name; }
+
 private:
-  struct Info {
-    int      frameIndex;
-    uint8_t  age;         ///< 8-bit aging counter (higher = more recently used).
-    bool     referenced;  ///< R-flag collected since last aging.
-  };
-  std::unordered_map<int, Info> table; ///< pageId -> Info
+  void growFrames(int frameIndex);
+
+  const nfu::Kernels*       kernels;   ///< Selected aging/argmin kernels.
+  std::vector<std::uint8_t> age;       ///< frame -> 8-bit aging counter (higher = more recently used).
+  std::vector<std::uint8_t> ref;       ///< frame -> 0x80 if referenced since last aging, else 0.
+  std::vector<std::uint8_t> invalid;   ///< frame -> 0xFF if no page is resident, else 0.
+  std::vector<int>          framePage; ///< frame -> resident page (-1 if none).
+  std::vector<int>          pageFrame; ///< pageId -> frame (-1 if not resident).
+  std::size_t               resident{0};
 };
 
+// Per-access hook, defined here so BasicSimulation<NFUAlgorithm> can inline it.
+
+inline void NFUAlgorithm::memoryAccess(int pageId) {
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    const int frame = pageFrame[pageId];
+    if (frame != -1) {
+        ref[frame] = 0x80; // mark referenced; age injection happens on aging step
+    }
+}
+
 #endif // CORE_ALGORITHMS_NFUALGORITHM_H
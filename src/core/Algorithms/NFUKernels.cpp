@@ -0,0 +1,173 @@
+/**
+* @file NFUKernels.cpp
+ * @brief Scalar and x86 SIMD implementations of the NFU aging kernels.
+ */
+#include "core/algorithms/NFUKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#  define NFU_X86 1
+#  include <immintrin.h>
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define NFU_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define NFU_TARGET_AVX2
+#endif
+
+namespace nfu {
+namespace {
+
+// ---------------- Scalar ----------------
+
+std::uint8_t ageAndMinScalar(std::uint8_t* age, std::uint8_t* ref,
+                             const std::uint8_t* invalid, std::size_t n) {
+    std::uint8_t m = 0xFF;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto a = static_cast<std::uint8_t>((age[i] >> 1) | ref[i] | invalid[i]);
+        age[i] = a;
+        ref[i] = 0;
+        if (a < m) m = a;
+    }
+    return m;
+}
+
+std::size_t findFirstScalar(const std::uint8_t* age, std::size_t n, std::uint8_t value) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (age[i] == value) return i;
+    }
+    return n;
+}
+
+#ifdef NFU_X86
+
+int ctz32(unsigned v) {
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward(&idx, v);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+// ---------------- SSE2 ----------------
+
+std::uint8_t ageAndMinSSE2(std::uint8_t* age, std::uint8_t* ref,
+                           const std::uint8_t* invalid, std::size_t n) {
+    const __m128i low7 = _mm_set1_epi8(0x7F);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i m = _mm_set1_epi8(static_cast<char>(0xFF));
+    for (std::size_t i = 0; i < n; i += 16) {
+        auto* pa = reinterpret_cast<__m128i*>(age + i);
+        auto* pr = reinterpret_cast<__m128i*>(ref + i);
+        const __m128i a = _mm_loadu_si128(pa);
+        // No 8-bit shift: shift 16-bit lanes and drop the bit that crossed over.
+        __m128i v = _mm_and_si128(_mm_srli_epi16(a, 1), low7);
+        v = _mm_or_si128(v, _mm_loadu_si128(pr));
+        v = _mm_or_si128(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(invalid + i)));
+        _mm_storeu_si128(pa, v);
+        _mm_storeu_si128(pr, zero);
+        m = _mm_min_epu8(m, v);
+    }
+    m = _mm_min_epu8(m, _mm_srli_si128(m, 8));
+    m = _mm_min_epu8(m, _mm_srli_si128(m, 4));
+    m = _mm_min_epu8(m, _mm_srli_si128(m, 2));
+    m = _mm_min_epu8(m, _mm_srli_si128(m, 1));
+    return static_cast<std::uint8_t>(_mm_cvtsi128_si32(m) & 0xFF);
+}
+
+std::size_t findFirstSSE2(const std::uint8_t* age, std::size_t n, std::uint8_t value) {
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    for (std::size_t i = 0; i < n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(age + i));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask) return i + ctz32(static_cast<unsigned>(mask));
+    }
+    return n;
+}
+
+// ---------------- AVX2 ----------------
+
+NFU_TARGET_AVX2
+std::uint8_t ageAndMinAVX2(std::uint8_t* age, std::uint8_t* ref,
+                           const std::uint8_t* invalid, std::size_t n) {
+    const __m256i low7 = _mm256_set1_epi8(0x7F);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i m = _mm256_set1_epi8(static_cast<char>(0xFF));
+    for (std::size_t i = 0; i < n; i += 32) {
+        auto* pa = reinterpret_cast<__m256i*>(age + i);
+        auto* pr = reinterpret_cast<__m256i*>(ref + i);
+        const __m256i a = _mm256_loadu_si256(pa);
+        __m256i v = _mm256_and_si256(_mm256_srli_epi16(a, 1), low7);
+        v = _mm256_or_si256(v, _mm256_loadu_si256(pr));
+        v = _mm256_or_si256(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(invalid + i)));
+        _mm256_storeu_si256(pa, v);
+        _mm256_storeu_si256(pr, zero);
+        m = _mm256_min_epu8(m, v);
+    }
+    __m128i h = _mm_min_epu8(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+    h = _mm_min_epu8(h, _mm_srli_si128(h, 8));
+    h = _mm_min_epu8(h, _mm_srli_si128(h, 4));
+    h = _mm_min_epu8(h, _mm_srli_si128(h, 2));
+    h = _mm_min_epu8(h, _mm_srli_si128(h, 1));
+    return static_cast<std::uint8_t>(_mm_cvtsi128_si32(h) & 0xFF);
+}
+
+NFU_TARGET_AVX2
+std::size_t findFirstAVX2(const std::uint8_t* age, std::size_t n, std::uint8_t value) {
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+    for (std::size_t i = 0; i < n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(age + i));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+        if (mask) return i + ctz32(mask);
+    }
+    return n;
+}
+
+bool cpuHasAVX2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // NFU_X86
+
+const Kernels kScalar{ageAndMinScalar, findFirstScalar, "scalar"};
+#ifdef NFU_X86
+const Kernels kSSE2{ageAndMinSSE2, findFirstSSE2, "sse2"};
+const Kernels kAVX2{ageAndMinAVX2, findFirstAVX2, "avx2"};
+#endif
+
+} // namespace
+
+const Kernels& kernels(Kernel k) {
+#ifdef NFU_X86
+    static const bool avx2 = cpuHasAVX2();
+    switch (k) {
+    case Kernel::Scalar: return kScalar;
+    case Kernel::SSE2:   return kSSE2;
+    case Kernel::AVX2:
+    case Kernel::Auto:   return avx2 ? kAVX2 : kSSE2;
+    }
+    return kSSE2;
+#else
+    (void)k;
+    return kScalar;
+#endif
+}
+
+} // namespace nfu
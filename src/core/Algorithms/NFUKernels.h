@@ -0,0 +1,51 @@
+/**
+* @file NFUKernels.h
+ * @brief Aging and argmin kernels for NFUAlgorithm (scalar, SSE2, AVX2).
+ */
+#ifndef CORE_ALGORITHMS_NFUKERNELS_H
+#define CORE_ALGORITHMS_NFUKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nfu {
+
+/// Arrays handed to the kernels are padded to a multiple of this many bytes.
+constexpr std::size_t kLaneBytes = 32;
+
+/// Kernel selection; Auto picks the best one the CPU supports.
+enum class Kernel { Auto, Scalar, SSE2, AVX2 };
+
+/**
+ * @brief Kernel table for one instruction set.
+ */
+struct Kernels {
+    /**
+     * @brief Age all slots and return the minimum age.
+     * @details age[i] = (age[i] >> 1) | ref[i] | invalid[i]; ref[i] = 0.
+     *          ref holds 0x80 for referenced slots, invalid holds 0xFF for
+     *          slots without a resident page (so they never win the argmin).
+     * @param n Number of slots, a multiple of @ref kLaneBytes.
+     */
+    std::uint8_t (*ageAndMin)(std::uint8_t* age, std::uint8_t* ref,
+                              const std::uint8_t* invalid, std::size_t n);
+
+    /**
+     * @brief Index of the first slot whose age equals @p value (n if none).
+     * @param n Number of slots, a multiple of @ref kLaneBytes.
+     */
+    std::size_t (*findFirst)(const std::uint8_t* age, std::size_t n, std::uint8_t value);
+
+    const char* name; ///< "scalar", "sse2" or "avx2".
+};
+
+/**
+ * @brief Resolve a kernel choice.
+ * @details Unsupported requests (e.g. AVX2 on a CPU without it, or any SIMD
+ *          kernel on a non-x86 target) fall back to the best supported one.
+ */
+const Kernels& kernels(Kernel k);
+
+} // namespace nfu
+
+#endif // CORE_ALGORITHMS_NFUKERNELS_H
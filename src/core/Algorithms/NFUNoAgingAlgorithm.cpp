@@ -4,11 +4,6 @@
  */
 #include "core/algorithms/NFUNoAgingAlgorithm.h"
 
-void NFUNoAgingAlgorithm::memoryAccess(int pageId) {
-    auto it = table.find(pageId);
-    if (it != table.end()) ++(it->second.counter);
-}
-
 int NFUNoAgingAlgorithm::selectVictimPage() {
     if (table.empty()) throw std::logic_error("NFU(no aging): empty table");
     unsigned int minCount = std::numeric_limits<unsigned int>::max();
@@ -27,3 +22,13 @@ int NFUNoAgingAlgorithm::selectVictimPage() {
 void NFUNoAgingAlgorithm::pageLoaded(int pageId, int frameIndex) {
     table[pageId] = Info{frameIndex, 0};
 }
+
+void NFUNoAgingAlgorithm::pageUnloaded(int pageId, int /*frameIndex*/) {
+    table.erase(pageId);
+}
+
+std::size_t NFUNoAgingAlgorithm::footprintBytes() const {
+    // Hash nodes: the entry plus a next pointer.
+    return table.bucket_count() * sizeof(void*)
+         + table.size() * (sizeof(decltype(table)::value_type) + sizeof(void*));
+}
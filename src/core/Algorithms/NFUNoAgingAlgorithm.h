@@ -13,7 +13,7 @@
 /**
  * @brief NFU w/o aging: evict the page with the smallest raw reference count.
  */
-class NFUNoAgingAlgorithm : public PagingAlgorithm {
+class NFUNoAgingAlgorithm final : public PagingAlgorithm {
 public:
     NFUNoAgingAlgorithm() = default;
     ~NFUNoAgingAlgorithm() override = default;
@@ -21,10 +21,19 @@ public:
     void memoryAccess(int pageId) override;
     int  selectVictimPage() override;
     void pageLoaded(int pageId, int frameIndex) override;
+    void pageUnloaded(int pageId, int frameIndex) override;
+    std::size_t footprintBytes() const override;
 
 private:
     struct Info { int frameIndex; unsigned int counter; };
     std::unordered_map<int, Info> table;
 };
 
+// Per-access hook, defined here so BasicSimulation<NFUNoAgingAlgorithm> can inline it.
+
+inline void NFUNoAgingAlgorithm::memoryAccess(int pageId) {
+    auto it = table.find(pageId);
+    if (it != table.end()) ++(it->second.counter);
+}
+
 #endif // CORE_ALGORITHMS_NFUNOAGINGALGORITHM_H
@@ -4,55 +4,131 @@
  */
 #include "core/algorithms/NRUAlgorithm.h"
 
-NRUAlgorithm::NRUAlgorithm(uint32_t seed) : rng(seed) {}
+#include <bit>
+#include <cstring>
+
+namespace {
 
-void NRUAlgorithm::memoryAccess(int pageId) {
-    ++accessCount;
-    auto it = table.find(pageId);
-    if (it != table.end()) it->second.referenced = true;
+constexpr int kWordBits = 64;
 
-    if (accessCount % resetPeriod == 0) {
-        for (auto &kv : table) kv.second.referenced = false;
+/// Class (R,D) members of one bitset word.
+inline std::uint64_t classWord(int cls, std::uint64_t used, std::uint64_t r, std::uint64_t d) {
+    switch (cls) {
+    case 0:  return used & ~r & ~d;
+    case 1:  return used & ~r &  d;
+    case 2:  return used &  r & ~d;
+    default: return used &  r &  d;
     }
 }
 
-void NRUAlgorithm::onWrite(int pageId) {
-    auto it = table.find(pageId);
-    if (it != table.end()) it->second.dirty = true;
+/// Position of the n-th (0-based) set bit of @p w.
+inline int selectBit(std::uint64_t w, int n) {
+    for (; n > 0; --n) w &= w - 1;
+    return std::countr_zero(w);
 }
 
-int NRUAlgorithm::pickRandom(const std::vector<int>& v) {
-    if (v.empty()) return -1;
-    std::uniform_int_distribution<> d(0, static_cast<int>(v.size())-1);
-    return v[d(rng)];
+} // namespace
+
+NRUAlgorithm::NRUAlgorithm(uint32_t seed) : rng(seed) {}
+
+void NRUAlgorithm::clearReferenced() {
+    if (!referenced.empty()) {
+        std::memset(referenced.data(), 0, referenced.size() * sizeof(Word));
+    }
 }
 
 int NRUAlgorithm::selectVictimPage() {
-    if (table.empty()) throw std::logic_error("NRU: empty table");
-
-    std::vector<int> c00, c01, c10, c11;
-    for (auto &kv : table) {
-        const auto &inf = kv.second;
-        if (!inf.referenced && !inf.dirty) c00.push_back(kv.first);
-        else if (!inf.referenced && inf.dirty) c01.push_back(kv.first);
-        else if (inf.referenced && !inf.dirty) c10.push_back(kv.first);
-        else c11.push_back(kv.first);
+    if (resident == 0) throw std::logic_error("NRU: empty table");
+
+    const std::size_t words = used.size();
+    std::size_t count[4] = {0, 0, 0, 0};
+    for (std::size_t w = 0; w < words; ++w) {
+        const Word u = used[w], r = referenced[w], d = dirty[w];
+        count[0] += std::popcount(u & ~r & ~d);
+        count[1] += std::popcount(u & ~r &  d);
+        count[2] += std::popcount(u &  r & ~d);
+        count[3] += std::popcount(u &  r &  d);
     }
-    int victimPage = pickRandom(c00);
-    if (victimPage == -1) victimPage = pickRandom(c01);
-    if (victimPage == -1) victimPage = pickRandom(c10);
-    if (victimPage == -1) victimPage = pickRandom(c11);
 
-    int victimFrame = table[victimPage].frameIndex;
-    table.erase(victimPage);
+    // Lowest non-empty class; one draw of the same distribution as before.
+    int cls = 0;
+    while (count[cls] == 0) ++cls;
+    std::uniform_int_distribution<> dist(0, static_cast<int>(count[cls]) - 1);
+    int nth = dist(rng);
 
-    for (auto &kv : table) {
-        kv.second.referenced = false;
+    int victimFrame = -1;
+    for (std::size_t w = 0; w < words; ++w) {
+        const Word members = classWord(cls, used[w], referenced[w], dirty[w]);
+        const int c = std::popcount(members);
+        if (nth < c) {
+            victimFrame = static_cast<int>(w) * kWordBits + selectBit(members, nth);
+            break;
+        }
+        nth -= c;
     }
 
+    const Word bit = Word{1} << (victimFrame % kWordBits);
+    used[victimFrame / kWordBits]  &= ~bit;
+    dirty[victimFrame / kWordBits] &= ~bit;
+    pageFrame[framePage[victimFrame]] = -1;
+    framePage[victimFrame] = -1;
+    --resident;
+
+    clearReferenced();
     return victimFrame;
 }
 
+void NRUAlgorithm::growFrames(int frameIndex) {
+    const std::size_t words = static_cast<std::size_t>(frameIndex) / kWordBits + 1;
+    used.resize(words, 0);
+    referenced.resize(words, 0);
+    dirty.resize(words, 0);
+    framePage.resize(words * kWordBits, -1);
+}
+
 void NRUAlgorithm::pageLoaded(int pageId, int frameIndex) {
-    table[pageId] = Info{frameIndex, true, false};
+    if (pageId < 0 || frameIndex < 0) return;
+    if (frameIndex / kWordBits >= static_cast<int>(used.size())) growFrames(frameIndex);
+    if (pageId >= static_cast<int>(pageFrame.size())) pageFrame.resize(pageId + 1, -1);
+
+    // Re-loading a tracked page or reusing a tracked frame replaces the old entry.
+    if (pageFrame[pageId] != -1) {
+        const int old = pageFrame[pageId];
+        const Word bit = Word{1} << (old % kWordBits);
+        used[old / kWordBits] &= ~bit;
+        referenced[old / kWordBits] &= ~bit;
+        dirty[old / kWordBits] &= ~bit;
+        framePage[old] = -1;
+        --resident;
+    }
+    if (framePage[frameIndex] != -1) {
+        pageFrame[framePage[frameIndex]] = -1;
+        --resident;
+    }
+
+    const Word bit = Word{1} << (frameIndex % kWordBits);
+    used[frameIndex / kWordBits]       |= bit;
+    referenced[frameIndex / kWordBits] |= bit;
+    dirty[frameIndex / kWordBits]      &= ~bit;
+    framePage[frameIndex] = pageId;
+    pageFrame[pageId]     = frameIndex;
+    ++resident;
+}
+
+void NRUAlgorithm::pageUnloaded(int pageId, int /*frameIndex*/) {
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    const int f = pageFrame[pageId];
+    if (f == -1) return;
+    const Word bit = Word{1} << (f % kWordBits);
+    used[f / kWordBits]       &= ~bit;
+    referenced[f / kWordBits] &= ~bit;
+    dirty[f / kWordBits]      &= ~bit;
+    framePage[f] = -1;
+    pageFrame[pageId] = -1;
+    --resident;
+}
+
+std::size_t NRUAlgorithm::footprintBytes() const {
+    return (used.capacity() + referenced.capacity() + dirty.capacity()) * sizeof(Word)
+         + (framePage.capacity() + pageFrame.capacity()) * sizeof(int);
 }
@@ -6,7 +6,7 @@
 #define CORE_ALGORITHMS_NRUALGORITHM_H
 
 #include "core/PagingAlgorithm.h"
-#include <unordered_map>
+#include <cstdint>
 #include <vector>
 #include <random>
 #include <stdexcept>
@@ -15,8 +15,13 @@
  * @brief NRU replacement using (referenced, dirty) classes.
  * @details Victim is chosen randomly from the lowest non-empty class:
  *          (R=0,D=0) -> (0,1) -> (1,0) -> (1,1). R bits are periodically reset.
+ *
+ *          R, D and "frame in use" are frame-indexed bitsets. Class membership is
+ *          computed word by word with AND/ANDN, the class sizes with popcount, and
+ *          the random pick selects the n-th set bit, so eviction does not allocate.
+ *          Within a class, members are numbered in frame order.
  */
-class NRUAlgorithm : public PagingAlgorithm {
+class NRUAlgorithm final : public PagingAlgorithm {
 public:
     /**
      * @brief Construct with a deterministic RNG seed.
@@ -30,15 +35,42 @@ public:
     void onWrite(int pageId) override;         ///< Track dirty bit on writes.
     int  selectVictimPage() override;
     void pageLoaded(int pageId, int frameIndex) override;
+    void pageUnloaded(int pageId, int frameIndex) override;
+    std::size_t footprintBytes() const override;
 
 private:
-    struct Info { int frameIndex; bool referenced; bool dirty; };
-    std::unordered_map<int, Info> table; ///< pageId -> Info
+    using Word = std::uint64_t;
+
+    void clearReferenced();
+    void growFrames(int frameIndex);
+
+    std::vector<Word> used;       ///< Bit f set: frame f holds a tracked page.
+    std::vector<Word> referenced; ///< Bit f set: R bit of frame f.
+    std::vector<Word> dirty;      ///< Bit f set: D bit of frame f.
+    std::vector<int>  framePage;  ///< frame -> pageId (-1 if none).
+    std::vector<int>  pageFrame;  ///< pageId -> frame (-1 if not resident).
+    std::size_t       resident{0};
     std::mt19937 rng;                    ///< RNG for random tie-breaking.
     int accessCount{0};                  ///< Counts accesses to schedule resets.
     int resetPeriod{64};                 ///< Reset R every N accesses.
-
-    int pickRandom(const std::vector<int>& v);
 };
 
+// Per-access hooks, defined here so BasicSimulation<NRUAlgorithm> can inline them.
+
+inline void NRUAlgorithm::memoryAccess(int pageId) {
+    ++accessCount;
+    if (pageId >= 0 && pageId < static_cast<int>(pageFrame.size())) {
+        const int f = pageFrame[pageId];
+        if (f != -1) referenced[f / 64] |= Word{1} << (f % 64);
+    }
+
+    if (accessCount % resetPeriod == 0) clearReferenced();
+}
+
+inline void NRUAlgorithm::onWrite(int pageId) {
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    const int f = pageFrame[pageId];
+    if (f != -1) dirty[f / 64] |= Word{1} << (f % 64);
+}
+
 #endif // CORE_ALGORITHMS_NRUALGORITHM_H
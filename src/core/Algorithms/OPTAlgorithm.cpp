@@ -0,0 +1,50 @@
+/**
+* @file OPTAlgorithm.cpp
+ * @brief Implementation of optimal page replacement.
+ */
+#include "core/algorithms/OPTAlgorithm.h"
+
+void OPTAlgorithm::grow(int frameIndex) {
+    if (frameIndex < leaves) return;
+    int n = leaves ? leaves : 1;
+    while (n <= frameIndex) n *= 2;
+    leaves = n;
+    key.resize(n, kEmpty);
+    framePage.resize(n, -1);
+    tree.assign(2 * n, 0);
+    for (int f = 0; f < n; ++f) tree[n + f] = f;
+    for (int node = n - 1; node >= 1; --node) tree[node] = better(tree[2 * node], tree[2 * node + 1]);
+}
+
+void OPTAlgorithm::pageLoaded(int pageId, int frameIndex) {
+    if (pageId < 0 || frameIndex < 0) return;
+    grow(frameIndex);
+    if (pageId >= static_cast<int>(pageFrame.size())) pageFrame.resize(pageId + 1, -1);
+
+    // Re-loading a tracked page or reusing a tracked frame replaces the old entry.
+    if (pageFrame[pageId] != -1) {
+        const int old = pageFrame[pageId];
+        framePage[old] = -1;
+        setKey(old, kEmpty);
+    }
+    if (framePage[frameIndex] != -1) pageFrame[framePage[frameIndex]] = -1;
+
+    framePage[frameIndex] = pageId;
+    pageFrame[pageId] = frameIndex;
+    // Loaded for the access at position clock, whose memoryAccess follows.
+    const std::uint64_t next = index->nextUse(clock);
+    setKey(frameIndex, next == NextUseIndex::kNever ? next : next + 1);
+}
+
+void OPTAlgorithm::pageUnloaded(int pageId, int frameIndex) {
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    if (pageFrame[pageId] != frameIndex) return;
+    pageFrame[pageId] = -1;
+    framePage[frameIndex] = -1;
+    setKey(frameIndex, kEmpty);
+}
+
+std::size_t OPTAlgorithm::footprintBytes() const {
+    return key.capacity() * sizeof(std::uint64_t)
+         + (framePage.capacity() + pageFrame.capacity() + tree.capacity()) * sizeof(int);
+}
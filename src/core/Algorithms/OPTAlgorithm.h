@@ -0,0 +1,93 @@
+/**
+* @file OPTAlgorithm.h
+ * @brief Belady's optimal (OPT/MIN) page replacement for a known trace.
+ */
+#ifndef CORE_ALGORITHMS_OPTALGORITHM_H
+#define CORE_ALGORITHMS_OPTALGORITHM_H
+
+#include "core/PagingAlgorithm.h"
+#include "analysis/NextUseIndex.h"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Evicts the resident page whose next use lies furthest in the future.
+ * @details With one page size it gives the fewest page faults any policy can
+ *          reach on the trace, so it serves as a lower bound next to the real
+ *          algorithms (with huge pages, which take many frames, furthest next
+ *          use is no longer optimal, only a strong heuristic). The
+ *          future comes from a @ref NextUseIndex of the same trace: the n-th
+ *          memoryAccess call is taken to be access n of the trace, so every
+ *          access must reach the algorithm (valid pages in table processes,
+ *          as set up by SharedTrace or LockstepRunner).
+ *
+ *          Each frame's key is the next use of its page. A tournament tree
+ *          over the frames keeps the frame with the largest key at the root:
+ *          an access or load updates one leaf and its path (O(log frames)),
+ *          and the victim is read off the root. Ties (e.g. several pages
+ *          never used again) go to the lowest frame.
+ */
+class OPTAlgorithm final : public PagingAlgorithm {
+public:
+    /** @param index Next-use index of the trace to be replayed (must outlive the algorithm). */
+    explicit OPTAlgorithm(const NextUseIndex& index) : index(&index) {}
+    ~OPTAlgorithm() override = default;
+
+    void memoryAccess(int pageId) override;
+    int  selectVictimPage() override;
+    void pageLoaded(int pageId, int frameIndex) override;
+    void pageUnloaded(int pageId, int frameIndex) override;
+    std::size_t footprintBytes() const override;
+
+    /** @return Number of accesses seen, i.e. the trace position of the next one. */
+    std::uint64_t position() const { return clock; }
+
+private:
+    /// Key of frames without a page; below every next-use position.
+    static constexpr std::uint64_t kEmpty = 0;
+
+    void grow(int frameIndex);
+    void setKey(int frame, std::uint64_t key);
+    int  better(int a, int b) const;
+
+    const NextUseIndex*        index;
+    std::uint64_t              clock{0};  ///< memoryAccess calls so far.
+    std::vector<std::uint64_t> key;       ///< frame -> 1 + next use of its page (kEmpty if free).
+    std::vector<int>           framePage; ///< frame -> page (-1 if free).
+    std::vector<int>           pageFrame; ///< pageId -> frame (-1 if not resident).
+    std::vector<int>           tree;      ///< Tournament tree: node -> winning frame; leaves at [leaves, 2*leaves).
+    int                        leaves{0};
+};
+
+// Per-access and per-eviction hooks, defined here so BasicSimulation<OPTAlgorithm> can inline them.
+
+inline int OPTAlgorithm::better(int a, int b) const {
+    return key[b] > key[a] ? b : a; // a is the lower frame of each pair
+}
+
+inline void OPTAlgorithm::setKey(int frame, std::uint64_t k) {
+    key[frame] = k;
+    for (int node = (leaves + frame) / 2; node >= 1; node /= 2) {
+        tree[node] = better(tree[2 * node], tree[2 * node + 1]);
+    }
+}
+
+inline void OPTAlgorithm::memoryAccess(int pageId) {
+    const std::uint64_t next = index->nextUse(clock++);
+    if (pageId < 0 || pageId >= static_cast<int>(pageFrame.size())) return;
+    const int frame = pageFrame[pageId];
+    if (frame == -1) return;
+    setKey(frame, next == NextUseIndex::kNever ? next : next + 1);
+}
+
+inline int OPTAlgorithm::selectVictimPage() {
+    const int victimFrame = leaves ? tree[1] : -1;
+    if (victimFrame == -1 || framePage[victimFrame] == -1) throw std::logic_error("OPT: empty table");
+    pageFrame[framePage[victimFrame]] = -1;
+    framePage[victimFrame] = -1;
+    setKey(victimFrame, kEmpty);
+    return victimFrame;
+}
+
+#endif // CORE_ALGORITHMS_OPTALGORITHM_H
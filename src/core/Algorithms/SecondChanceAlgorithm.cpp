@@ -4,11 +4,6 @@
  */
 #include "core/algorithms/SecondChanceAlgorithm.h"
 
-void SecondChanceAlgorithm::memoryAccess(int pageId) {
-    auto it = pageMap.find(pageId);
-    if (it != pageMap.end()) it->second->referenced = true;
-}
-
 int SecondChanceAlgorithm::selectVictimPage() {
     if (clockList.empty()) throw std::logic_error("SecondChance: empty clock");
     while (true) {
@@ -30,3 +25,17 @@ void SecondChanceAlgorithm::pageLoaded(int pageId, int frameIndex) {
     clockList.push_back(e);
     pageMap[pageId] = std::prev(clockList.end());
 }
+
+void SecondChanceAlgorithm::pageUnloaded(int pageId, int /*frameIndex*/) {
+    auto it = pageMap.find(pageId);
+    if (it == pageMap.end()) return;
+    clockList.erase(it->second);
+    pageMap.erase(it);
+}
+
+std::size_t SecondChanceAlgorithm::footprintBytes() const {
+    // List nodes carry two links, hash nodes one.
+    return clockList.size() * (sizeof(Entry) + 2 * sizeof(void*))
+         + pageMap.bucket_count() * sizeof(void*)
+         + pageMap.size() * (sizeof(decltype(pageMap)::value_type) + sizeof(void*));
+}
@@ -13,7 +13,7 @@
 /**
  * @brief Second-Chance using a circular list and referenced bits.
  */
-class SecondChanceAlgorithm : public PagingAlgorithm {
+class SecondChanceAlgorithm final : public PagingAlgorithm {
 public:
     SecondChanceAlgorithm() = default;
     ~SecondChanceAlgorithm() override = default;
@@ -21,6 +21,8 @@ public:
     void memoryAccess(int pageId) override;
     int  selectVictimPage() override;
     void pageLoaded(int pageId, int frameIndex) override;
+    void pageUnloaded(int pageId, int frameIndex) override;
+    std::size_t footprintBytes() const override;
 
 private:
     struct Entry { int pageId; int frameIndex; bool referenced; };
@@ -28,4 +30,11 @@ private:
     std::unordered_map<int, std::list<Entry>::iterator> pageMap; ///< pageId -> node.
 };
 
+// Per-access hook, defined here so BasicSimulation<SecondChanceAlgorithm> can inline it.
+
+inline void SecondChanceAlgorithm::memoryAccess(int pageId) {
+    auto it = pageMap.find(pageId);
+    if (it != pageMap.end()) it->second->referenced = true;
+}
+
 #endif // CORE_ALGORITHMS_SECONDCHANCEALGORITHM_H
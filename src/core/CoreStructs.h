@@ -5,8 +5,12 @@
 #ifndef CORESTRUCTS_H
 #define CORESTRUCTS_H
 
+#include <cstdint>
 #include <vector>
-#include <deque>
+
+#include "core/AddressSpace.h"
+#include "core/PageTable.h"
+#include "core/TLB.h"
 
 /** @brief One physical memory frame. */
 struct PageFrame {
@@ -18,111 +22,126 @@ struct PageFrame {
     int        accessCounter{0};     ///< Optional: number of accesses.
 };
 
-/** @brief One entry in the page table. */
-struct PageTableEntry {
-    bool isPresent{false}; ///< Present/valid bit.
-    int  frameIndex{-1};   ///< Mapped physical frame (-1 if none).
-};
+/** @brief A minimal process model containing a page table. */
+struct Process {
+    unsigned char process_id{0}; ///< Process identifier.
+    PageTable     page_table;    ///< Page table.
+    AddressSpace  address_space; ///< Translation of address accesses (4 KiB pages, no huge pages by default).
 
-/** @brief Page table for a process. */
-struct PageTable {
-    std::vector<PageTableEntry> entries; ///< Entries indexed by page ID.
-    explicit PageTable(unsigned int numVirtualPages) : entries(numVirtualPages) {}
-};
+    Process(unsigned char id, unsigned int numVirtualPages)
+      : process_id(id), page_table(numVirtualPages) {}
 
-/** @brief One TLB entry (page -> frame). */
-struct TLBEntry {
-    int           page_index{-1};   ///< Virtual page.
-    int           frame_index{-1};  ///< Physical frame.
-    unsigned char frame_attributes{0}; ///< Optional attribute bits.
+    /** @brief Process with a page table of the given layout (e.g. sparse radix). */
+    Process(unsigned char id, std::uint64_t numVirtualPages, PageTableKind kind)
+      : process_id(id), page_table(numVirtualPages, kind) {}
 };
 
 /**
- * @brief A simple FIFO TLB with capacity-bound storage.
- * @details Can be extended to LRU or other policies.
+ * @brief Minimal MMU wrapper that holds the TLBs and the current process.
+ * @details @ref tlb is probed on every access, or @ref hugeTlb for huge pages
+ *          if that L1 is configured. An optional second-level TLB (@ref stlb,
+ *          capacity 0 = none) holds pages of all sizes and is probed on an L1
+ *          miss; the helpers below keep the levels consistent with @ref stlbFill.
+ * @tparam Tlb TLB model of every level; anything with the interface of @ref TLB.
  */
-struct TLB {
-    std::deque<TLBEntry> entries;   ///< FIFO container (front = oldest).
-    unsigned int         capacity{0}; ///< Maximum entries.
+template <class Tlb>
+struct BasicMMU {
+    Tlb       tlb;                       ///< Translation lookaside buffer (L1).
+    Tlb       stlb;                      ///< Second-level TLB (capacity 0 = none).
+    Tlb       hugeTlb;                   ///< L1 TLB for huge pages (capacity 0 = they use @ref tlb).
+    TLBFill   stlbFill{TLBFill::Inclusive}; ///< Fill policy between L1 and L2.
+    Process*  currentProcess{nullptr};   ///< Active process whose page table is consulted.
 
-    explicit TLB(unsigned int cap) : capacity(cap) {}
+    explicit BasicMMU(unsigned int tlbCapacity) : tlb(tlbCapacity), stlb(0u), hugeTlb(0u) {}
+    /** @brief MMU with a TLB of the given shape and replacement policy. */
+    explicit BasicMMU(const TLBConfig& tlbConfig) : tlb(tlbConfig), stlb(0u), hugeTlb(0u) {}
+    /** @brief MMU with an L1/L2 TLB hierarchy. */
+    explicit BasicMMU(const TLBHierarchyConfig& config)
+      : tlb(config.l1.tlb), stlb(config.l2.tlb), hugeTlb(config.huge), stlbFill(config.fill) {}
 
-    /** @brief Remove all entries. */
-    void clear() { entries.clear(); }
+    /** @return True if a second-level TLB is configured. */
+    bool hasSTLB() const { return stlb.capacity() != 0; }
+
+    /** @return L1 TLB that holds pages of the given kind. */
+    Tlb& l1(bool huge) { return huge && hugeTlb.capacity() != 0 ? hugeTlb : tlb; }
 
     /**
-     * @brief Look up a page in the TLB.
+     * @brief Probe the L2 TLB after an L1 miss and move a hit into L1.
      * @param pageIndex Virtual page.
-     * @return Frame index or -1 if not found.
+     * @param huge True if the page is a huge page.
+     * @return Frame index or -1 if L2 misses too.
      */
-    int lookup(int pageIndex) const {
-        for (const auto& e : entries) {
-            if (e.page_index == pageIndex) return e.frame_index;
+    int lookupSTLB(int pageIndex, bool huge = false) {
+        const int frameIndex = stlb.lookup(pageIndex);
+        if (frameIndex != -1) {
+            if (stlbFill == TLBFill::Exclusive) stlb.remove(pageIndex);
+            fillL1(pageIndex, frameIndex, huge);
         }
-        return -1;
+        return frameIndex;
     }
 
     /**
-     * @brief Insert or update a TLB entry using FIFO replacement.
+     * @brief Install a translation found by a page walk.
      * @param pageIndex Virtual page.
      * @param frameIndex Physical frame.
+     * @param huge True if the page is a huge page.
      */
-    void addOrUpdate(int pageIndex, int frameIndex) {
-        if (capacity == 0) return;
-        for (auto it = entries.begin(); it != entries.end(); ++it) {
-            if (it->page_index == pageIndex) { entries.erase(it); break; }
+    void fill(int pageIndex, int frameIndex, bool huge = false) {
+        if (hasSTLB() && stlbFill == TLBFill::Inclusive) {
+            const TLBEntry evicted = stlb.addOrUpdate(pageIndex, frameIndex);
+            if (evicted.page_index != -1) {
+                tlb.remove(evicted.page_index, evicted.asid);
+                hugeTlb.remove(evicted.page_index, evicted.asid);
+            }
         }
-        if (entries.size() == capacity) entries.pop_front();
-        entries.push_back(TLBEntry{pageIndex, frameIndex, 0});
+        fillL1(pageIndex, frameIndex, huge);
     }
 
     /**
-     * @brief Remove the entry that references a given frame, if any.
-     * @param victim_frame_index Frame to remove.
+     * @brief Drop any translation to a frame from all levels.
+     * @param frameIndex Physical frame.
      */
-    void deleteEntryByFrame(int victim_frame_index) {
-        for (auto it = entries.begin(); it != entries.end(); ++it) {
-            if (it->frame_index == victim_frame_index) { entries.erase(it); break; }
-        }
+    void invalidateFrame(int frameIndex) {
+        tlb.deleteEntryByFrame(frameIndex);
+        stlb.deleteEntryByFrame(frameIndex);
+        hugeTlb.deleteEntryByFrame(frameIndex);
     }
 
     /**
-     * @brief Reverse lookup: get the page mapped to a frame.
-     * @param frame_index Frame to check.
-     * @return Page index or -1.
+     * @brief Change the current process and clear the TLBs.
+     * @param p Process pointer (no ownership).
      */
-    int getPageForFrame(int frame_index) const {
-        for (const auto& e : entries) {
-            if (e.frame_index == frame_index) return e.page_index;
-        }
-        return -1;
+    void setCurrentProcess(Process* p) {
+        tlb.clear();
+        stlb.clear();
+        hugeTlb.clear();
+        switchProcess(p);
     }
-};
-
-/** @brief A minimal process model containing a page table. */
-struct Process {
-    unsigned char process_id{0}; ///< Process identifier.
-    PageTable     page_table;    ///< Page table.
-
-    Process(unsigned char id, unsigned int numVirtualPages)
-      : process_id(id), page_table(numVirtualPages) {}
-};
-
-/** @brief Minimal MMU wrapper that holds a TLB and the current process. */
-struct MMU {
-    TLB       tlb;                       ///< Translation lookaside buffer.
-    Process*  currentProcess{nullptr};   ///< Active process whose page table is consulted.
-
-    explicit MMU(unsigned int tlbCapacity) : tlb(tlbCapacity) {}
 
     /**
-     * @brief Change the current process and clear the TLB.
-     * @param p Process pointer (no ownership).
+     * @brief Context switch without a flush: TLB entries are ASID-tagged (O(1)).
+     * @param p Process pointer (no ownership); its process_id is the ASID.
      */
-    void setCurrentProcess(Process* p) {
+    void switchProcess(Process* p) {
         currentProcess = p;
-        tlb.clear();
+        const unsigned char asid = p ? p->process_id : 0;
+        tlb.setASID(asid);
+        stlb.setASID(asid);
+        hugeTlb.setASID(asid);
+    }
+
+private:
+    void fillL1(int pageIndex, int frameIndex, bool huge) {
+        Tlb& level = l1(huge);
+        if (level.capacity() == 0) return; // TLB off: skip building an empty TLBEntry on every walk
+        const TLBEntry evicted = level.addOrUpdate(pageIndex, frameIndex);
+        if (evicted.page_index != -1 && hasSTLB() && stlbFill == TLBFill::Exclusive) {
+            stlb.addOrUpdate(evicted);
+        }
     }
 };
 
+/// The MMU of @ref Simulation.
+using MMU = BasicMMU<TLB>;
+
 #endif // CORESTRUCTS_H
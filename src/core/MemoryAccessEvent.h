@@ -6,24 +6,54 @@
 #ifndef MEMORYACCESSEVENT_H
 #define MEMORYACCESSEVENT_H
 
+#include <cstdint>
+
 /**
- * @brief Memory access event with optional write flag.
+ * @brief Memory access event with optional write flag and issuing process.
+ * @details The access names either a virtual page ID directly or a 64-bit
+ *          virtual address (@ref atAddress), which the simulation translates
+ *          with the issuing process's AddressSpace.
  */
 class MemoryAccessEvent {
-  int  pageId_;  ///< Virtual page being accessed.
-  bool write_;   ///< True if this is a write access.
+  std::uint64_t target_;     ///< Page ID (sign-extended) or virtual address.
+  bool          write_;      ///< True if this is a write access.
+  unsigned char processId_;  ///< Issuing process (Process::process_id).
+  bool          address_{false}; ///< True if target_ is a virtual address.
 public:
   /**
    * @brief Construct a memory access event.
    * @param pageId Virtual page ID.
    * @param write True if write access; false for read.
+   * @param processId Issuing process; 0 for single-process traces.
+   */
+  MemoryAccessEvent(int pageId, bool write=false, unsigned char processId=0)
+    : target_(static_cast<std::uint64_t>(static_cast<std::int64_t>(pageId))),
+      write_(write), processId_(processId) {}
+
+  /**
+   * @brief Construct an access to a virtual address.
+   * @param address 64-bit virtual address.
+   * @param write True if write access; false for read.
+   * @param processId Issuing process; 0 for single-process traces.
    */
-  MemoryAccessEvent(int pageId, bool write=false) : pageId_(pageId), write_(write) {}
+  static MemoryAccessEvent atAddress(std::uint64_t address, bool write=false,
+                                     unsigned char processId=0) {
+    MemoryAccessEvent ev(0, write, processId);
+    ev.target_  = address;
+    ev.address_ = true;
+    return ev;
+  }
 
-  /** @return Virtual page ID. */
-  int  pageId()  const { return pageId_; }
+  /** @return Virtual page ID (meaningless for address accesses). */
+  int  pageId()  const { return static_cast<int>(target_); }
+  /** @return True if the access names a virtual address instead of a page ID. */
+  bool isAddress() const { return address_; }
+  /** @return Virtual address (address accesses only). */
+  std::uint64_t address() const { return target_; }
   /** @return True if this is a write access. */
   bool write()   const { return write_; }
+  /** @return ID of the process that issued the access. */
+  unsigned char processId() const { return processId_; }
 };
 
 #endif // MEMORYACCESSEVENT_H
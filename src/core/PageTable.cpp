@@ -0,0 +1,50 @@
+/**
+ * @file PageTable.cpp
+ * @brief Implementation of the radix page table.
+ */
+#include "core/PageTable.h"
+
+#include <stdexcept>
+#include <string>
+
+const PageTableEntry* RadixPageTable::find(std::uint64_t vpn, int& levels) const {
+    levels = 1;
+    if (interior_.size() == 0) return nullptr;
+    std::uint32_t node = 0;
+    for (int level = 0; level < kLevels - 1; ++level) {
+        const std::uint32_t c = interior_[node].child[indexAt(vpn, level)];
+        if (c == 0) return nullptr;
+        ++levels;
+        if (level == kLevels - 2) return &leaves_[c - 1].pte[indexAt(vpn, kLevels - 1)];
+        node = c - 1;
+    }
+    return nullptr;
+}
+
+PageTableEntry& RadixPageTable::at(std::uint64_t vpn) {
+    if (interior_.size() == 0) interior_.allocate(); // root
+    std::uint32_t node = 0;
+    for (int level = 0; level < kLevels - 1; ++level) {
+        const unsigned int i = indexAt(vpn, level);
+        std::uint32_t c = interior_[node].child[i];
+        if (c == 0) {
+            // Allocate before taking a reference: the arena may add a chunk.
+            c = (level == kLevels - 2 ? leaves_.allocate() : interior_.allocate()) + 1;
+            interior_[node].child[i] = c;
+        }
+        if (level == kLevels - 2) return leaves_[c - 1].pte[indexAt(vpn, kLevels - 1)];
+        node = c - 1;
+    }
+    return leaves_[0].pte[0]; // not reached
+}
+
+PageTable::PageTable(std::uint64_t numVirtualPages, PageTableKind kind)
+    : numPages_(numVirtualPages), radix_(kind == PageTableKind::Radix)
+{
+    if (!radix_) {
+        entries.resize(numVirtualPages);
+    } else if (numVirtualPages > RadixPageTable::kMaxPages) {
+        throw std::invalid_argument("PageTable: radix table covers at most "
+                                    + std::to_string(RadixPageTable::kMaxPages) + " pages");
+    }
+}
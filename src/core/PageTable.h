@@ -0,0 +1,183 @@
+/**
+ * @file PageTable.h
+ * @brief Page tables: dense array or sparse x86-64-style 4-level radix tree.
+ */
+#ifndef CORE_PAGETABLE_H
+#define CORE_PAGETABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** @brief One entry in the page table. */
+struct PageTableEntry {
+    bool isPresent{false}; ///< Present/valid bit.
+    int  frameIndex{-1};   ///< Mapped physical frame (-1 if none).
+};
+
+/**
+ * @brief Sparse 4-level radix page table (9 index bits per level, 512-entry nodes).
+ * @details Like x86-64 with 4 KiB pages, a 36-bit virtual page number is split
+ *          into four 9-bit indices: three interior levels of child links and a
+ *          leaf level of @ref PageTableEntry. Nodes are allocated on first
+ *          mapping from two arenas (interior and leaf), which hand out
+ *          index-addressed nodes in fixed-size chunks; nothing is allocated for
+ *          unmapped regions and lookups never allocate.
+ */
+class RadixPageTable {
+public:
+    static constexpr int           kLevels       = 4;
+    static constexpr int           kBitsPerLevel = 9;
+    static constexpr std::size_t   kFanout       = std::size_t{1} << kBitsPerLevel;
+    static constexpr std::uint64_t kMaxPages     = std::uint64_t{1} << (kLevels * kBitsPerLevel);
+
+    /**
+     * @brief Walk the tree without allocating.
+     * @param vpn Virtual page number (< kMaxPages).
+     * @param levels Receives the number of nodes visited (1..kLevels).
+     * @return The leaf entry, or nullptr if an interior node on the path is absent.
+     */
+    const PageTableEntry* find(std::uint64_t vpn, int& levels) const;
+    PageTableEntry*       find(std::uint64_t vpn, int& levels) {
+        return const_cast<PageTableEntry*>(static_cast<const RadixPageTable*>(this)->find(vpn, levels));
+    }
+
+    /**
+     * @brief Return the leaf entry for @p vpn, allocating missing nodes on the path.
+     * @param vpn Virtual page number (< kMaxPages).
+     */
+    PageTableEntry& at(std::uint64_t vpn);
+
+    /**
+     * @brief Call fn(vpn, entry) for every present entry, in ascending page order.
+     */
+    template <class Fn>
+    void forEachPresent(Fn&& fn) {
+        if (interior_.size() == 0) return;
+        visit(0, 0, 0, fn);
+    }
+
+    /** @return Bytes held by allocated nodes. */
+    std::size_t footprintBytes() const { return interior_.bytes() + leaves_.bytes(); }
+    /** @return Number of allocated interior nodes (including the root). */
+    std::size_t interiorNodes() const { return interior_.size(); }
+    /** @return Number of allocated leaf nodes. */
+    std::size_t leafNodes() const { return leaves_.size(); }
+
+private:
+    /// Child links; 0 = absent, otherwise node index + 1.
+    struct Interior { std::uint32_t child[kFanout]{}; };
+    struct Leaf     { PageTableEntry pte[kFanout]; };
+
+    /// Index-addressed node pool; nodes never move once allocated.
+    template <class T>
+    class Arena {
+    public:
+        static constexpr std::size_t kChunkShift = 3; ///< 8 nodes per chunk (16/32 KiB).
+        static constexpr std::size_t kChunkSize  = std::size_t{1} << kChunkShift;
+
+        std::uint32_t allocate() {
+            if ((size_ & (kChunkSize - 1)) == 0) chunks_.emplace_back(kChunkSize);
+            return static_cast<std::uint32_t>(size_++);
+        }
+        T&       operator[](std::uint32_t i)       { return chunks_[i >> kChunkShift][i & (kChunkSize - 1)]; }
+        const T& operator[](std::uint32_t i) const { return chunks_[i >> kChunkShift][i & (kChunkSize - 1)]; }
+        std::size_t size()  const { return size_; }
+        std::size_t bytes() const { return chunks_.size() * kChunkSize * sizeof(T); }
+
+    private:
+        std::vector<std::vector<T>> chunks_;
+        std::size_t                 size_{0};
+    };
+
+    static unsigned int indexAt(std::uint64_t vpn, int level) {
+        return static_cast<unsigned int>(vpn >> (kBitsPerLevel * (kLevels - 1 - level))) & (kFanout - 1);
+    }
+
+    template <class Fn>
+    void visit(std::uint32_t node, int level, std::uint64_t prefix, Fn& fn) {
+        for (std::size_t i = 0; i < kFanout; ++i) {
+            const std::uint32_t c = interior_[node].child[i];
+            if (c == 0) continue;
+            const std::uint64_t vpn = (prefix << kBitsPerLevel) | i;
+            if (level + 1 < kLevels - 1) {
+                visit(c - 1, level + 1, vpn, fn);
+            } else {
+                Leaf& leaf = leaves_[c - 1];
+                for (std::size_t j = 0; j < kFanout; ++j) {
+                    if (leaf.pte[j].isPresent) fn((vpn << kBitsPerLevel) | j, leaf.pte[j]);
+                }
+            }
+        }
+    }
+
+    Arena<Interior> interior_; ///< Node 0 is the root once anything is mapped.
+    Arena<Leaf>     leaves_;
+};
+
+/** @brief Page table layout. */
+enum class PageTableKind {
+    Dense, ///< One entry per virtual page, allocated up front.
+    Radix  ///< Sparse 4-level tree; nodes allocated on first mapping.
+};
+
+/**
+ * @brief Page table for a process.
+ * @details Dense tables keep their entries in @ref entries (as before); radix
+ *          tables leave it empty and store entries in a @ref RadixPageTable.
+ *          Simulation goes through find/at/forEachPresent, which work for both.
+ */
+struct PageTable {
+    std::vector<PageTableEntry> entries; ///< Dense: entries indexed by page ID (empty for radix).
+
+    explicit PageTable(unsigned int numVirtualPages)
+      : entries(numVirtualPages), numPages_(numVirtualPages) {}
+
+    /**
+     * @brief Page table of a given layout.
+     * @param numVirtualPages Number of valid pages (radix: at most RadixPageTable::kMaxPages).
+     * @param kind Dense or radix layout.
+     * @throws std::invalid_argument if a radix table is larger than kMaxPages.
+     */
+    PageTable(std::uint64_t numVirtualPages, PageTableKind kind);
+
+    /** @return Layout of this table. */
+    PageTableKind kind() const { return radix_ ? PageTableKind::Radix : PageTableKind::Dense; }
+    /** @return Number of valid virtual pages. */
+    std::uint64_t numPages() const { return numPages_; }
+
+    /**
+     * @brief Look up a page without allocating.
+     * @param page Page ID (< numPages()).
+     * @param levels Receives the number of table levels referenced (dense: 1).
+     * @return The entry, or nullptr if no table node covers the page yet.
+     */
+    PageTableEntry* find(std::uint64_t page, int& levels) {
+        if (!radix_) { levels = 1; return &entries[page]; }
+        return tree_.find(page, levels);
+    }
+
+    /** @brief Entry for @p page (< numPages()), allocating radix nodes if needed. */
+    PageTableEntry& at(std::uint64_t page) { return radix_ ? tree_.at(page) : entries[page]; }
+
+    /** @brief Call fn(page, entry) for every present entry. */
+    template <class Fn>
+    void forEachPresent(Fn&& fn) {
+        if (radix_) { tree_.forEachPresent(fn); return; }
+        for (std::size_t p = 0; p < entries.size(); ++p) {
+            if (entries[p].isPresent) fn(static_cast<std::uint64_t>(p), entries[p]);
+        }
+    }
+
+    /** @return Bytes of page-table memory in use. */
+    std::size_t footprintBytes() const {
+        return radix_ ? tree_.footprintBytes() : entries.size() * sizeof(PageTableEntry);
+    }
+
+private:
+    std::uint64_t  numPages_{0};
+    bool           radix_{false};
+    RadixPageTable tree_;
+};
+
+#endif // CORE_PAGETABLE_H
@@ -5,13 +5,25 @@
 #ifndef PAGINGALGORITHM_H
 #define PAGINGALGORITHM_H
 
+#include <cstddef>
+
+/**
+ * @brief Replacement policy driven by page accesses, loads and evictions.
+ * @details The @c pageId argument of every hook is a key for a resident page,
+ *          not its virtual page ID: BasicSimulation passes the index of the
+ *          frame the page occupies (so @ref pageLoaded and @ref pageUnloaded
+ *          get the frame index twice). Keys stay below the frame count, and a
+ *          key is reused for another page once the frame is refilled. Policies
+ *          that index arrays by key are then bounded by the physical memory,
+ *          whatever the size of the address spaces.
+ */
 class PagingAlgorithm {
 public:
  virtual ~PagingAlgorithm() = default;
 
  /**
   * @brief Notify the algorithm about an access to a page.
-  * @param pageId Virtual page ID that was accessed.
+  * @param pageId Key of the accessed page: the frame index it occupies.
   */
  virtual void memoryAccess(int pageId) = 0;
 
@@ -23,16 +35,32 @@ public:
 
  /**
   * @brief Notify that a page has been loaded into a specific frame.
-  * @param pageId Virtual page ID.
+  * @param pageId Key of the loaded page: its frame index (equal to @p frameIndex).
   * @param frameIndex Physical frame index.
   */
  virtual void pageLoaded(int pageId, int frameIndex) = 0;
 
  /**
   * @brief Optional hook for write accesses (dirty tracking).
-  * @param pageId Virtual page ID that was written.
+  * @param pageId Key of the written page: the frame index it occupies.
   */
  virtual void onWrite(int /*pageId*/) {}
+
+ /**
+  * @brief Notify that a resident page was removed without an eviction
+  *        (explicit frame release, e.g. process exit).
+  * @details The policy must forget the page; the frame may be reused by a
+  *          later @ref pageLoaded. Policies without per-page state may ignore it.
+  * @param pageId Key of the removed page: its frame index (equal to @p frameIndex).
+  * @param frameIndex Physical frame it occupied.
+  */
+ virtual void pageUnloaded(int /*pageId*/, int /*frameIndex*/) {}
+
+ /**
+  * @brief Memory held by the policy's per-page and per-frame state.
+  * @return Bytes (capacity of its tables, estimated for node-based containers).
+  */
+ virtual std::size_t footprintBytes() const { return 0; }
 };
 
 #endif // PAGINGALGORITHM_H
@@ -0,0 +1,222 @@
+/**
+ * @file TLB.cpp
+ * @brief Implementation of the set-associative TLB.
+ */
+#include "core/TLB.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+TLB::TLB(const TLBConfig& config) : config_(config), capacity_(config.capacity) {
+    ways_ = (config.ways == 0 || config.ways > capacity_) ? capacity_ : config.ways;
+    if (capacity_ == 0) return;
+
+    if (capacity_ % ways_ != 0) {
+        throw std::invalid_argument("TLB: ways (" + std::to_string(ways_)
+                                    + ") must divide capacity (" + std::to_string(capacity_) + ")");
+    }
+    const unsigned int sets = capacity_ / ways_;
+    if (!std::has_single_bit(sets)) {
+        throw std::invalid_argument("TLB: number of sets must be a power of two, got "
+                                    + std::to_string(sets));
+    }
+    if (config.replacement == TLBReplacement::PLRU
+        && (!std::has_single_bit(ways_) || ways_ > 64)) {
+        throw std::invalid_argument("TLB: PLRU needs a power-of-two way count <= 64");
+    }
+    setMask_ = sets - 1;
+
+    keys_.assign(capacity_, kInvalidKey);
+    frames_.assign(capacity_, -1);
+    stamps_.assign(capacity_, 0);
+    if (config.replacement == TLBReplacement::PLRU) plru_.assign(sets, 0);
+    rng_ = config.seed ? config.seed : 1;
+}
+
+void TLB::clear() {
+    for (unsigned int s = 0; s < capacity_; ++s) {
+        if (keys_[s] != kInvalidKey) invalidate(s);
+    }
+    std::fill(plru_.begin(), plru_.end(), 0);
+}
+
+void TLB::flushASID(unsigned char asid) {
+    for (unsigned int s = 0; s < capacity_; ++s) {
+        if (keys_[s] != kInvalidKey && (keys_[s] >> 32) == asid) invalidate(s);
+    }
+}
+
+unsigned int TLB::setOf(int pageIndex) const {
+    // Low-order page bits select the set, as in hardware TLBs.
+    return static_cast<unsigned int>(pageIndex) & setMask_;
+}
+
+void TLB::touch(unsigned int set, unsigned int way) const {
+    switch (config_.replacement) {
+    case TLBReplacement::LRU:
+        stamps_[set * ways_ + way] = ++clock_;
+        break;
+    case TLBReplacement::PLRU: {
+        // Tree bits point towards the next victim; point every node on the
+        // path to the touched way away from it.
+        const int levels = std::countr_zero(ways_);
+        std::uint64_t bits = plru_[set];
+        unsigned int node = 0;
+        for (int l = levels - 1; l >= 0; --l) {
+            const unsigned int dir = (way >> l) & 1u;
+            if (dir) bits &= ~(std::uint64_t{1} << node);
+            else     bits |=  (std::uint64_t{1} << node);
+            node = 2 * node + 1 + dir;
+        }
+        plru_[set] = bits;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+unsigned int TLB::chooseVictim(unsigned int set, unsigned int oldest) const {
+    switch (config_.replacement) {
+    case TLBReplacement::Random:
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        return static_cast<unsigned int>(rng_ % ways_);
+    case TLBReplacement::PLRU: {
+        const int levels = std::countr_zero(ways_);
+        const std::uint64_t bits = plru_[set];
+        unsigned int node = 0, way = 0;
+        for (int l = 0; l < levels; ++l) {
+            const unsigned int dir = (bits >> node) & 1u;
+            way = (way << 1) | dir;
+            node = 2 * node + 1 + dir;
+        }
+        return way;
+    }
+    default:
+        // FIFO and LRU: smallest stamp (oldest insert / least recent use).
+        return oldest;
+    }
+}
+
+void TLB::invalidate(unsigned int slot) {
+    const int frame = frames_[slot];
+    if (frame >= 0 && static_cast<std::size_t>(frame) < frameSlot_.size()
+        && frameSlot_[frame] == static_cast<int>(slot)) {
+        frameSlot_[frame] = -1;
+    }
+    keys_[slot]   = kInvalidKey;
+    frames_[slot] = -1;
+    stamps_[slot] = 0;
+    --size_;
+}
+
+unsigned int TLB::findWay(unsigned int base, std::uint64_t key) const {
+    const std::uint64_t* k = keys_.data() + base;
+    unsigned int w = 0;
+    // Wide sets: test eight ways at a time without branching (vectorizes).
+    for (; w + 8 <= ways_; w += 8) {
+        bool any = false;
+        for (unsigned int i = 0; i < 8; ++i) any |= k[w + i] == key;
+        if (any) break;
+    }
+    for (; w < ways_; ++w) {
+        if (k[w] == key) return w;
+    }
+    return ways_;
+}
+
+int TLB::lookup(int pageIndex) const {
+    if (capacity_ == 0) return -1;
+    const unsigned int set  = setOf(pageIndex);
+    const unsigned int base = set * ways_;
+    const unsigned int way  = findWay(base, keyOf(pageIndex, asid_));
+    if (way == ways_) return -1;
+    touch(set, way);
+    return frames_[base + way];
+}
+
+TLBEntry TLB::addOrUpdate(const TLBEntry& entry) {
+    TLBEntry evicted;
+    if (capacity_ == 0) return evicted;
+    const int          frameIndex = entry.frame_index;
+    const std::uint64_t key       = keyOf(entry.page_index, entry.asid);
+    const unsigned int set        = setOf(entry.page_index);
+    const unsigned int base       = set * ways_;
+
+    // A frame holds one page: drop a stale entry still pointing at it.
+    if (frameIndex >= 0) {
+        if (static_cast<std::size_t>(frameIndex) >= frameSlot_.size()) {
+            frameSlot_.resize(static_cast<std::size_t>(frameIndex) + 1, -1);
+        }
+        const int old = frameSlot_[frameIndex];
+        if (old >= 0 && keys_[old] != key) invalidate(static_cast<unsigned int>(old));
+    }
+
+    unsigned int way = findWay(base, key);
+    if (way == ways_) {
+        // Free ways have stamp 0, so the oldest way is a free one if there is any.
+        const std::uint64_t* st = stamps_.data() + base;
+        unsigned int oldest = 0;
+        for (unsigned int w = 1; w < ways_; ++w) {
+            oldest = st[w] < st[oldest] ? w : oldest;
+        }
+        way = st[oldest] == 0 ? oldest : chooseVictim(set, oldest);
+        if (keys_[base + way] != kInvalidKey) {
+            const std::uint64_t k = keys_[base + way];
+            evicted = TLBEntry{pageOf(k), frames_[base + way], 0, static_cast<unsigned char>(k >> 32)};
+            invalidate(base + way);
+        }
+        ++size_;
+    } else if (frames_[base + way] != frameIndex) {
+        const int prev = frames_[base + way];
+        if (prev >= 0 && frameSlot_[prev] == static_cast<int>(base + way)) frameSlot_[prev] = -1;
+    }
+
+    const unsigned int slot = base + way;
+    keys_[slot]   = key;
+    frames_[slot] = frameIndex;
+    if (frameIndex >= 0) frameSlot_[frameIndex] = static_cast<int>(slot);
+
+    // Insert/update makes the entry youngest for both FIFO and LRU.
+    stamps_[slot] = ++clock_;
+    touch(set, way);
+    return evicted;
+}
+
+bool TLB::remove(int pageIndex, unsigned char asid) {
+    if (capacity_ == 0) return false;
+    const unsigned int base = setOf(pageIndex) * ways_;
+    const unsigned int way  = findWay(base, keyOf(pageIndex, asid));
+    if (way == ways_) return false;
+    invalidate(base + way);
+    return true;
+}
+
+void TLB::deleteEntryByFrame(int victim_frame_index) {
+    if (victim_frame_index < 0
+        || static_cast<std::size_t>(victim_frame_index) >= frameSlot_.size()) return;
+    const int slot = frameSlot_[victim_frame_index];
+    if (slot >= 0) invalidate(static_cast<unsigned int>(slot));
+}
+
+int TLB::getPageForFrame(int frame_index) const {
+    if (frame_index < 0 || static_cast<std::size_t>(frame_index) >= frameSlot_.size()) return -1;
+    const int slot = frameSlot_[frame_index];
+    return slot >= 0 ? pageOf(keys_[slot]) : -1;
+}
+
+std::vector<TLBEntry> TLB::entries() const {
+    std::vector<TLBEntry> out;
+    out.reserve(size_);
+    for (unsigned int s = 0; s < capacity_; ++s) {
+        if (keys_[s] != kInvalidKey) {
+            out.push_back(TLBEntry{pageOf(keys_[s]), frames_[s], 0,
+                                   static_cast<unsigned char>(keys_[s] >> 32)});
+        }
+    }
+    return out;
+}
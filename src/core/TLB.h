@@ -0,0 +1,199 @@
+/**
+ * @file TLB.h
+ * @brief Configurable translation lookaside buffer (fully or N-way set-associative).
+ */
+#ifndef CORE_TLB_H
+#define CORE_TLB_H
+
+#include <cstdint>
+#include <vector>
+
+/** @brief One TLB entry (page -> frame). */
+struct TLBEntry {
+    int           page_index{-1};   ///< Virtual page.
+    int           frame_index{-1};  ///< Physical frame.
+    unsigned char frame_attributes{0}; ///< Optional attribute bits.
+    unsigned char asid{0};          ///< Address-space ID (Process::process_id) of the entry.
+};
+
+/** @brief Replacement policy inside one TLB set. */
+enum class TLBReplacement {
+    FIFO,   ///< Oldest insert/update goes first (the classic behaviour).
+    LRU,    ///< Least recently looked up or updated goes first.
+    Random, ///< Uniformly random way (deterministic seed).
+    PLRU    ///< Tree pseudo-LRU; ways must be a power of two (<= 64).
+};
+
+/** @brief Shape and policy of a TLB. */
+struct TLBConfig {
+    unsigned int   capacity{0};   ///< Total entries (0 disables the TLB).
+    unsigned int   ways{0};       ///< Associativity; 0 or capacity = fully associative.
+    TLBReplacement replacement{TLBReplacement::FIFO}; ///< Policy within a set.
+    std::uint32_t  seed{1};       ///< Seed for TLBReplacement::Random.
+};
+
+/** @brief How a second-level TLB is filled relative to the first level. */
+enum class TLBFill {
+    Inclusive, ///< Walks fill both levels; an L2 eviction also removes the page from L1.
+    Exclusive  ///< Walks fill L1 only; L1 victims move to L2 (victim cache), L2 hits move up.
+};
+
+/** @brief One level of a TLB hierarchy. */
+struct TLBLevelConfig {
+    TLBConfig tlb;           ///< Shape and replacement policy.
+    double    latency{1.0};  ///< Time charged for probing this level (simulation units).
+};
+
+/** @brief Two-level TLB: per-core L1 (dTLB) backed by a shared L2 (STLB). */
+struct TLBHierarchyConfig {
+    TLBLevelConfig l1;                      ///< Probed on every access.
+    TLBLevelConfig l2;                      ///< Probed on an L1 miss; capacity 0 = no L2.
+    TLBFill        fill{TLBFill::Inclusive}; ///< Fill policy between the levels.
+    TLBConfig      huge;  ///< Separate L1 for 2 MiB/1 GiB pages, probed instead of l1 (capacity 0 = shared L1).
+};
+
+/**
+ * @brief TLB with a flat, set-major array layout.
+ * @details A page maps to one set by hash; only that set's ways are probed.
+ *          Entries are stored as parallel arrays (pages, frames, stamps) so a
+ *          probe scans one contiguous run of page numbers. A reverse index
+ *          frame -> slot makes invalidation by frame O(1).
+ *
+ *          The default (fully associative, FIFO) reproduces the former deque
+ *          TLB exactly: inserting or updating a page makes it the youngest
+ *          entry and the oldest entry is replaced when the TLB is full.
+ *
+ *          Entries are tagged with an address-space ID. Page lookups and
+ *          inserts use the current ASID (@ref setASID), so switching
+ *          processes is O(1) and needs no flush; entries of other processes
+ *          stay resident and compete for the same sets.
+ */
+struct TLB {
+    /**
+     * @brief Fully associative FIFO TLB.
+     * @param cap Number of entries.
+     */
+    explicit TLB(unsigned int cap) : TLB(TLBConfig{cap}) {}
+
+    /**
+     * @brief TLB with an explicit configuration.
+     * @throws std::invalid_argument if ways do not divide the capacity, the set
+     *         count is not a power of two, or PLRU is used with unsupported ways.
+     */
+    explicit TLB(const TLBConfig& config);
+
+    /** @brief Remove all entries of all address spaces. */
+    void clear();
+
+    /**
+     * @brief Select the address space used by page lookups and inserts (O(1)).
+     * @param asid Address-space ID, normally Process::process_id.
+     */
+    void setASID(unsigned char asid) { asid_ = asid; }
+    /** @return Current address-space ID. */
+    unsigned char asid() const { return asid_; }
+
+    /**
+     * @brief Remove all entries of one address space (e.g. when its ID is reused).
+     * @param asid Address-space ID to flush.
+     */
+    void flushASID(unsigned char asid);
+
+    /**
+     * @brief Look up a page of the current address space.
+     * @details Updates the replacement state (LRU/PLRU) on a hit; that state is
+     *          not part of the visible TLB contents, hence const.
+     * @param pageIndex Virtual page.
+     * @return Frame index or -1 if not found.
+     */
+    int lookup(int pageIndex) const;
+
+    /**
+     * @brief Insert or update an entry of the current address space,
+     *        replacing within the page's set if needed.
+     * @param pageIndex Virtual page.
+     * @param frameIndex Physical frame.
+     * @return The entry replaced to make room (page_index -1 if none).
+     */
+    TLBEntry addOrUpdate(int pageIndex, int frameIndex) {
+        return addOrUpdate(TLBEntry{pageIndex, frameIndex, 0, asid_});
+    }
+
+    /**
+     * @brief Insert or update an entry of any address space (entry.asid).
+     * @param entry Page, frame and ASID to install.
+     * @return The entry replaced to make room (page_index -1 if none).
+     */
+    TLBEntry addOrUpdate(const TLBEntry& entry);
+
+    /**
+     * @brief Remove the entry for a page, if present.
+     * @param pageIndex Virtual page.
+     * @param asid Address space of the page.
+     * @return True if an entry was removed.
+     */
+    bool remove(int pageIndex, unsigned char asid);
+    /** @brief Remove the entry for a page of the current address space. */
+    bool remove(int pageIndex) { return remove(pageIndex, asid_); }
+
+    /**
+     * @brief Remove the entry that references a given frame, if any (O(1)).
+     * @param victim_frame_index Frame to remove.
+     */
+    void deleteEntryByFrame(int victim_frame_index);
+
+    /**
+     * @brief Reverse lookup: get the page mapped to a frame (O(1)).
+     * @param frame_index Frame to check.
+     * @return Page index or -1.
+     */
+    int getPageForFrame(int frame_index) const;
+
+    /** @return Valid entries in slot order (set-major), e.g. for display. */
+    std::vector<TLBEntry> entries() const;
+
+    /** @return Number of valid entries. */
+    unsigned int size() const { return size_; }
+    /** @return Maximum number of entries. */
+    unsigned int capacity() const { return capacity_; }
+    /** @return Entries per set. */
+    unsigned int ways() const { return ways_; }
+    /** @return Number of sets. */
+    unsigned int sets() const { return setMask_ + 1; }
+    /** @return Configuration this TLB was built with. */
+    const TLBConfig& config() const { return config_; }
+
+private:
+    static constexpr std::uint64_t kInvalidKey = ~std::uint64_t{0};
+
+    /// Tag compared on lookup: ASID in the high half, page in the low half.
+    static std::uint64_t keyOf(int pageIndex, unsigned char asid) {
+        return (std::uint64_t{asid} << 32) | static_cast<std::uint32_t>(pageIndex);
+    }
+    static int pageOf(std::uint64_t key) { return static_cast<int>(static_cast<std::uint32_t>(key)); }
+
+    unsigned int setOf(int pageIndex) const;
+    unsigned int findWay(unsigned int base, std::uint64_t key) const;
+    unsigned int chooseVictim(unsigned int set, unsigned int oldest) const;
+    void touch(unsigned int set, unsigned int way) const;
+    void invalidate(unsigned int slot);
+
+    TLBConfig    config_;
+    unsigned int capacity_{0};
+    unsigned int ways_{0};
+    unsigned int setMask_{0};
+    unsigned int size_{0};
+    unsigned char asid_{0};                 ///< Current address space.
+
+    std::vector<std::uint64_t> keys_;       ///< slot -> ASID/page tag (kInvalidKey = free); slot = set * ways + way.
+    std::vector<int>           frames_;     ///< slot -> frame.
+    std::vector<int>           frameSlot_;  ///< frame -> slot (-1 if none).
+
+    // Replacement state (mutable: lookups refresh recency).
+    mutable std::vector<std::uint64_t> stamps_;  ///< slot -> insert (FIFO) / use (LRU) time; 0 = free.
+    mutable std::vector<std::uint64_t> plru_;    ///< set -> tree-PLRU bits.
+    mutable std::uint64_t              clock_{0};
+    mutable std::uint64_t              rng_{1};
+};
+
+#endif // CORE_TLB_H
@@ -6,41 +6,191 @@
 #include "des/EventQueue.h"
 #include "des/Event.h"
 
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Heap comparator: true if @p a runs after @p b (min-heap on (time, seq)).
+template <class Node>
+bool later(const Node& a, const Node& b) {
+    return a.time > b.time || (a.time == b.time && a.seq > b.seq);
+}
+
+/// Lane compaction threshold (consumed prefix length).
+constexpr std::size_t kLaneCompact = 4096;
+
+} // namespace
+
 EventQueue::EventQueue() = default;
-EventQueue::~EventQueue() = default;
-EventQueue::EventQueue(EventQueue&&) noexcept = default;
-EventQueue& EventQueue::operator=(EventQueue&&) noexcept = default;
 
-bool EventQueue::Cmp::operator()(const std::unique_ptr<Event>& a,
-                                 const std::unique_ptr<Event>& b) const
+EventQueue::EventQueue(Backend backend, double bucketWidth, std::size_t numBuckets)
+    : backend_(backend)
 {
-    return a->time() > b->time();
+    if (backend_ == Backend::Calendar) {
+        std::size_t n = 1;
+        while (n < numBuckets) n <<= 1;
+        buckets_.resize(n);
+        bucketWidth_ = bucketWidth > 0 ? bucketWidth : 1.0;
+    }
 }
 
+EventQueue::~EventQueue() = default;
+EventQueue::EventQueue(EventQueue&&) noexcept = default;
+EventQueue& EventQueue::operator=(EventQueue&&) noexcept = default;
+
 void EventQueue::AddEvent(Event* e)
 {
     if (!e) return;
-    pq_.emplace(e);
+    const double t = e->time();
+    schedule(t, [ev = std::unique_ptr<Event>(e)]() { ev->run(); });
 }
 
 void EventQueue::run()
 {
-    while (!pq_.empty()) {
+    while (!empty()) {
         step();
     }
 }
 
 void EventQueue::step()
 {
-    if (pq_.empty()) return;
+    if (empty()) return;
 
-    std::unique_ptr<Event> ev = std::move(const_cast<std::unique_ptr<Event>&>(pq_.top()));
-    pq_.pop();
+    const Node n = pop();
+    // Free the slot even if the action throws; new events scheduled by the
+    // action get other slots, the running one stays valid until it returns.
+    struct Release {
+        EventQueue* q; std::uint32_t s;
+        ~Release() { q->releaseSlot(s); }
+    } release{this, n.slot};
 
-    ev->run();
+    slot(n.slot)();
 }
 
 void EventQueue::clear()
 {
-    while (!pq_.empty()) pq_.pop();
+    for (std::size_t i = laneHead_; i < lane_.size(); ++i) releaseSlot(lane_[i].slot);
+    lane_.clear();
+    laneHead_ = 0;
+
+    for (const Node& n : heap_) releaseSlot(n.slot);
+    heap_.clear();
+    for (auto& b : buckets_) {
+        for (const Node& n : b) releaseSlot(n.slot);
+        b.clear();
+    }
+    backendSize_ = 0;
+}
+
+std::uint32_t EventQueue::nextFreeSlot()
+{
+    if (freeSlots_.empty()) {
+        const auto base = static_cast<std::uint32_t>(slabs_.size() << kSlabShift);
+        slabs_.push_back(std::make_unique<InlineAction[]>(kSlabMask + 1));
+        freeSlots_.reserve(freeSlots_.size() + kSlabMask + 1);
+        for (std::uint32_t i = kSlabMask + 1; i-- > 0;) freeSlots_.push_back(base + i);
+    }
+    return freeSlots_.back();
+}
+
+void EventQueue::releaseSlot(std::uint32_t i)
+{
+    slot(i).reset();
+    freeSlots_.push_back(i);
+}
+
+void EventQueue::insert(const Node& n)
+{
+    // Fast lane: keeps FIFO order as long as times do not decrease.
+    if (laneHead_ == lane_.size() || !(n.time < lane_.back().time)) {
+        if (laneHead_ == lane_.size()) {
+            lane_.clear();
+            laneHead_ = 0;
+        }
+        lane_.push_back(n);
+        return;
+    }
+    backendPush(n);
+}
+
+EventQueue::Node EventQueue::pop()
+{
+    const bool haveLane = laneHead_ < lane_.size();
+    const Node* top = backendSize_ ? backendTop() : nullptr;
+
+    if (haveLane && (!top || before(lane_[laneHead_], *top))) {
+        const Node n = lane_[laneHead_++];
+        if (laneHead_ >= kLaneCompact && laneHead_ * 2 >= lane_.size()) {
+            lane_.erase(lane_.begin(), lane_.begin() + static_cast<std::ptrdiff_t>(laneHead_));
+            laneHead_ = 0;
+        }
+        return n;
+    }
+    return backendPop();
+}
+
+// ---------------- Backends ----------------
+
+std::int64_t EventQueue::windowOf(double t) const
+{
+    // Clamp before the cast (out-of-range conversion is undefined); far-off
+    // events share the edge window, whose bucket heap still orders them. The
+    // headroom keeps curWindow_ + buckets_.size() from overflowing.
+    constexpr double kMaxWindow = 0x1p62;
+    const double w = std::floor(t / bucketWidth_);
+    if (!(w < kMaxWindow)) return static_cast<std::int64_t>(kMaxWindow);
+    if (!(w > -kMaxWindow)) return -static_cast<std::int64_t>(kMaxWindow);
+    return static_cast<std::int64_t>(w);
+}
+
+void EventQueue::backendPush(const Node& n)
+{
+    // State changes only after push_back, which may throw.
+    if (backend_ == Backend::BinaryHeap) {
+        heap_.push_back(n);
+        std::push_heap(heap_.begin(), heap_.end(), later<Node>);
+        ++backendSize_;
+        return;
+    }
+    const std::int64_t w = windowOf(n.time);
+    auto& b = buckets_[static_cast<std::uint64_t>(w) & (buckets_.size() - 1)];
+    b.push_back(n);
+    std::push_heap(b.begin(), b.end(), later<Node>);
+    // Everything pending in the calendar is at or after curWindow_; an
+    // earlier event moves the serving position back so it is not skipped.
+    if (++backendSize_ == 1 || w < curWindow_) curWindow_ = w;
+}
+
+const EventQueue::Node* EventQueue::backendTop()
+{
+    if (backend_ == Backend::BinaryHeap) return &heap_.front();
+
+    const std::size_t mask = buckets_.size() - 1;
+    // Scan one "year" of windows starting at the current one.
+    for (std::size_t i = 0; i < buckets_.size(); ++i, ++curWindow_) {
+        const auto& b = buckets_[static_cast<std::uint64_t>(curWindow_) & mask];
+        if (!b.empty() && windowOf(b.front().time) == curWindow_) return &b.front();
+    }
+    // Sparse calendar: jump straight to the earliest pending event.
+    const Node* best = nullptr;
+    for (const auto& b : buckets_) {
+        if (!b.empty() && (!best || before(b.front(), *best))) best = &b.front();
+    }
+    curWindow_ = windowOf(best->time);
+    return best;
+}
+
+EventQueue::Node EventQueue::backendPop()
+{
+    --backendSize_;
+    std::vector<Node>* h = &heap_;
+    if (backend_ == Backend::Calendar) {
+        backendTop(); // positions curWindow_ on the earliest event
+        h = &buckets_[static_cast<std::uint64_t>(curWindow_) & (buckets_.size() - 1)];
+    }
+    std::pop_heap(h->begin(), h->end(), later<Node>);
+    const Node n = h->back();
+    h->pop_back();
+    return n;
 }
@@ -2,15 +2,26 @@
  * @file EventQueue.h
  * @brief Discrete-Event Simulation (DES) priority queue.
  *
- * This queue stores events ordered by their scheduled time (ascending).
- * It owns the events; when an event is executed via step() or run(),
- * the event object is destroyed automatically.
+ * This queue stores events ordered by their scheduled time (ascending);
+ * events with equal time run in the order they were added.
+ * Each event's action lives in a pooled, fixed-size slot (see
+ * @ref InlineAction); the pending set itself holds small
+ * (time, sequence, slot) records, so ordering never chases pointers and
+ * scheduling does not allocate once the pool has grown.
+ * When an event is executed via step() or run(), its action is destroyed
+ * and its slot is reused.
+ *
+ * Events whose time is not earlier than the last event added to the FIFO
+ * lane (e.g. trace accesses at t += delta) are appended to that lane in O(1);
+ * only out-of-order events go to the backend, which is a binary heap by
+ * default or a calendar queue (fixed bucket width) for workloads with a
+ * bounded time horizon. The next event is the smaller of both fronts.
  *
  * Typical usage:
  * @code{.cpp}
  * EventQueue q;
- * q.AddEvent(new Event([](){}, 1.0)); // do something at t=1.0
- * q.AddEvent(new Event([](){}, 2.0)); // do something at t=2.0
+ * q.schedule(1.0, [](){});             // do something at t=1.0
+ * q.AddEvent(new Event([](){}, 2.0));  // legacy form, takes ownership
  * q.step(); // executes the earliest (time=1.0)
  * q.run();  // executes the rest
  * @endcode
@@ -20,22 +31,64 @@
 #define EVENTQUEUE_H
 
 #include <memory>
-#include <queue>
 #include <vector>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "des/InlineAction.h"
 
 class Event;
 
 class EventQueue {
 public:
+    /// Storage for events that do not fit the FIFO lane.
+    enum class Backend {
+        BinaryHeap, ///< O(log n) insert and remove; no tuning needed.
+        Calendar    ///< O(1) expected when events spread over ~numBuckets * bucketWidth.
+    };
+
     EventQueue();
+    /**
+     * @brief Construct with a specific backend.
+     * @param backend Storage for out-of-order events.
+     * @param bucketWidth Calendar: time span of one bucket (> 0).
+     * @param numBuckets Calendar: number of buckets (rounded up to a power of two).
+     */
+    explicit EventQueue(Backend backend, double bucketWidth = 1.0, std::size_t numBuckets = 1024);
     ~EventQueue();
     EventQueue(const EventQueue&) = delete;
     EventQueue& operator=(const EventQueue&) = delete;
     EventQueue(EventQueue&&) noexcept;
     EventQueue& operator=(EventQueue&&) noexcept;
 
-    /// Add an event (takes ownership).
+    /**
+     * @brief Schedule a callable at time @p t without allocating an Event.
+     * @param t Simulation time at which to execute.
+     * @param f Callable invocable as `f()`; stored inline if small enough.
+     * @details If copying @p f or growing the queue throws, nothing is scheduled
+     *          and the slot stays in the pool.
+     * @throws std::invalid_argument if @p t is NaN or infinite.
+     */
+    template <class F>
+    void schedule(double t, F&& f) {
+        if (!std::isfinite(t)) throw std::invalid_argument("EventQueue: event time must be finite");
+        // The slot leaves the free list only once the action is stored and queued.
+        const std::uint32_t s = nextFreeSlot();
+        slot(s).emplace(std::forward<F>(f));
+        try {
+            insert(Node{t, nextSeq_, s});
+        } catch (...) {
+            slot(s).reset();
+            throw;
+        }
+        freeSlots_.pop_back();
+        ++nextSeq_;
+    }
+
+    /// Add an event (takes ownership; a non-finite time throws as in schedule() and deletes it).
     void AddEvent(Event* e);
     /// Execute all remaining events.
     void run();
@@ -44,24 +97,57 @@ public:
     /// Remove all pending events without executing.
     void clear();
 
-    bool empty() const { return pq_.empty(); }
-    std::size_t size() const { return pq_.size(); }
+    bool empty() const { return size() == 0; }
+    std::size_t size() const { return (lane_.size() - laneHead_) + backendSize_; }
+
+    /** @return Backend selected at construction. */
+    Backend backend() const { return backend_; }
 
 private:
-    /// Comparator for min-heap by event time
-    struct Cmp {
-        bool operator()(const std::unique_ptr<Event>& a,
-                        const std::unique_ptr<Event>& b) const;
+    /// Heap record: ordering key plus the pool slot holding the action.
+    struct Node {
+        double        time;  ///< Scheduled time.
+        std::uint64_t seq;   ///< Insertion order (stable tie-break).
+        std::uint32_t slot;  ///< Index into the action pool.
     };
 
-    using Ptr = std::unique_ptr<Event>;
+    static constexpr std::uint32_t kSlabShift = 10;               ///< 1024 slots per slab.
+    static constexpr std::uint32_t kSlabMask  = (1u << kSlabShift) - 1;
+
+    /// Strict order on (time, seq).
+    static bool before(const Node& a, const Node& b) {
+        return a.time < b.time || (a.time == b.time && a.seq < b.seq);
+    }
+
+    InlineAction& slot(std::uint32_t i) { return slabs_[i >> kSlabShift][i & kSlabMask]; }
+    std::uint32_t nextFreeSlot(); ///< Top of the free list (grown if empty), not yet taken.
+    void releaseSlot(std::uint32_t i);
+    void insert(const Node& n);
+    Node pop();
+
+    void        backendPush(const Node& n);
+    const Node* backendTop();
+    Node        backendPop();
+    std::int64_t windowOf(double t) const; ///< Calendar window of a finite time, clamped to +-2^62.
+
+    Backend backend_{Backend::BinaryHeap};
+
+    // FIFO lane: non-decreasing times, served from laneHead_.
+    std::vector<Node> lane_;
+    std::size_t       laneHead_{0};
+
+    // Backend: binary min-heap by (time, seq), earliest at heap_[0] ...
+    std::vector<Node> heap_;
+    // ... or calendar: buckets_[window & mask] is a min-heap by (time, seq).
+    std::vector<std::vector<Node>> buckets_;
+    double                         bucketWidth_{1.0};
+    std::int64_t                   curWindow_{0};   ///< Window currently being served.
+    std::size_t                    backendSize_{0};
 
-    // Min-heap: the smallest time on top.
-    std::priority_queue<
-        Ptr,
-        std::vector<Ptr>,
-        Cmp
-    > pq_;
+    // Action pool.
+    std::vector<std::unique_ptr<InlineAction[]>> slabs_;      ///< Slot storage, never moved.
+    std::vector<std::uint32_t>                   freeSlots_;  ///< Recycled slot indices.
+    std::uint64_t                                nextSeq_{0};
 };
 
 #endif // EVENTQUEUE_H
@@ -0,0 +1,73 @@
+/**
+ * @file InlineAction.h
+ * @brief Small-buffer callable used as the storage slot of pooled DES events.
+ */
+#ifndef DES_INLINEACTION_H
+#define DES_INLINEACTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Holds one `void()` callable, inline if it fits into 48 bytes.
+ * @details Unlike std::function the object is never moved or copied: it lives
+ *          in a fixed pool slot of @ref EventQueue, is filled with @ref emplace,
+ *          called once and then @ref reset. Callables that are too large (or not
+ *          nothrow-movable) fall back to a single heap allocation.
+ *          sizeof(InlineAction) is one cache line on 64-bit targets.
+ */
+class InlineAction {
+public:
+    /// Bytes available for an inline callable.
+    static constexpr std::size_t kInlineBytes = 48;
+
+    InlineAction() = default;
+    ~InlineAction() { reset(); }
+    InlineAction(const InlineAction&) = delete;
+    InlineAction& operator=(const InlineAction&) = delete;
+
+    /**
+     * @brief Store a callable (the slot must be empty).
+     * @param f Callable invocable as `f()`.
+     */
+    template <class F>
+    void emplace(F&& f) {
+        using T = std::decay_t<F>;
+        if constexpr (sizeof(T) <= kInlineBytes
+                      && alignof(T) <= alignof(std::max_align_t)
+                      && std::is_nothrow_move_constructible_v<T>) {
+            ::new (static_cast<void*>(buf_)) T(std::forward<F>(f));
+            invoke_  = [](void* p) { (*static_cast<T*>(p))(); };
+            destroy_ = [](void* p) { static_cast<T*>(p)->~T(); };
+        } else {
+            T* heap = new T(std::forward<F>(f));
+            ::new (static_cast<void*>(buf_)) T*(heap);
+            invoke_  = [](void* p) { (**static_cast<T**>(p))(); };
+            destroy_ = [](void* p) { delete *static_cast<T**>(p); };
+        }
+    }
+
+    /** @brief Invoke the stored callable. */
+    void operator()() { invoke_(buf_); }
+
+    /** @brief Destroy the stored callable (no-op if empty). */
+    void reset() {
+        if (destroy_) {
+            destroy_(buf_);
+            destroy_ = nullptr;
+            invoke_  = nullptr;
+        }
+    }
+
+    /** @return True if a callable is stored. */
+    explicit operator bool() const { return invoke_ != nullptr; }
+
+private:
+    alignas(std::max_align_t) unsigned char buf_[kInlineBytes];
+    void (*invoke_)(void*)  = nullptr;
+    void (*destroy_)(void*) = nullptr;
+};
+
+#endif // DES_INLINEACTION_H
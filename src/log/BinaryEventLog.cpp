@@ -0,0 +1,169 @@
+/**
+ * @file BinaryEventLog.cpp
+ * @brief Implementation of the binary step log writer and reader.
+ */
+#include "log/BinaryEventLog.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char          kMagic[8] = {'P', 'S', 'L', 'O', 'G', '\0', '\0', '\0'};
+constexpr std::uint32_t kVersion  = 1;
+constexpr std::size_t   kHeaderBytes = 16;
+
+void putU32(unsigned char* p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+void putU64(unsigned char* p, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+std::uint32_t getU32(const unsigned char* p) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= std::uint32_t(p[i]) << (8 * i);
+    return v;
+}
+std::uint64_t getU64(const unsigned char* p) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= std::uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+/// Layout: step u64 | page i32 | frame i32 | aux i32 | kind u8 | write u8 | 2 reserved.
+void encode(const LogRecord& r, unsigned char* p) {
+    putU64(p,      r.step);
+    putU32(p + 8,  static_cast<std::uint32_t>(r.page));
+    putU32(p + 12, static_cast<std::uint32_t>(r.frame));
+    putU32(p + 16, static_cast<std::uint32_t>(r.aux));
+    p[20] = static_cast<unsigned char>(r.kind);
+    p[21] = r.write ? 1 : 0;
+    p[22] = p[23] = 0;
+}
+
+LogRecord decode(const unsigned char* p) {
+    LogRecord r;
+    r.step  = getU64(p);
+    r.page  = static_cast<std::int32_t>(getU32(p + 8));
+    r.frame = static_cast<std::int32_t>(getU32(p + 12));
+    r.aux   = static_cast<std::int32_t>(getU32(p + 16));
+    r.kind  = static_cast<LogEventKind>(p[20]);
+    r.write = p[21] != 0;
+    return r;
+}
+
+std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+BinaryEventLog::BinaryEventLog(const std::string& filename, std::size_t ringCapacity)
+    : ring_(roundUpPow2(ringCapacity)), filename_(filename)
+{
+    mask_ = ring_.size() - 1;
+    file_ = std::fopen(filename.c_str(), "wb");
+    if (!file_) throw std::runtime_error("Cannot open event log: " + filename);
+
+    unsigned char header[kHeaderBytes];
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    putU32(header + 8,  kVersion);
+    putU32(header + 12, static_cast<std::uint32_t>(kRecordBytes));
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        std::fclose(file_);
+        throw std::runtime_error("Write error on event log: " + filename);
+    }
+
+    writer_ = std::thread(&BinaryEventLog::writerLoop, this);
+}
+
+BinaryEventLog::~BinaryEventLog() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n'; // destructors must not throw; call close() to handle it
+    }
+}
+
+void BinaryEventLog::record(const LogRecord& r) {
+    if (!file_) return; // closed: the writer is gone, so a full ring would never drain
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    // Ring full: wait for the writer instead of dropping records.
+    while (head - tail_.load(std::memory_order_acquire) == ring_.size()) {
+        std::this_thread::yield();
+    }
+    ring_[head & mask_] = r;
+    head_.store(head + 1, std::memory_order_release);
+    ++produced_;
+}
+
+std::size_t BinaryEventLog::drain() {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    const std::size_t n = head - tail;
+    if (n == 0) return 0;
+
+    out_.resize(n * kRecordBytes);
+    for (std::size_t i = 0; i < n; ++i) {
+        encode(ring_[(tail + i) & mask_], out_.data() + i * kRecordBytes);
+    }
+    tail_.store(head, std::memory_order_release);
+    // After a failed write keep consuming, so the producer never waits on a dead file.
+    if (!writeFailed_ && std::fwrite(out_.data(), 1, out_.size(), file_) != out_.size()) writeFailed_ = true;
+    return n;
+}
+
+void BinaryEventLog::writerLoop() {
+    while (!stop_.load(std::memory_order_acquire)) {
+        if (drain() == 0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    drain(); // producer has stopped: flush the rest
+}
+
+void BinaryEventLog::close() {
+    if (!file_) return;
+    stop_.store(true, std::memory_order_release);
+    if (writer_.joinable()) writer_.join();
+    const bool closeFailed = std::fclose(file_) != 0; // buffered data is flushed here
+    file_ = nullptr;
+    if (writeFailed_ || closeFailed) throw std::runtime_error("Write error on event log: " + filename_);
+}
+
+std::uint64_t readBinaryEventLog(const std::string& filename,
+                                 const std::function<void(const LogRecord&)>& fn) {
+    std::FILE* f = std::fopen(filename.c_str(), "rb");
+    if (!f) throw std::runtime_error("Cannot open event log: " + filename);
+
+    unsigned char header[kHeaderBytes];
+    if (std::fread(header, 1, sizeof(header), f) != sizeof(header)
+        || std::memcmp(header, kMagic, sizeof(kMagic)) != 0
+        || getU32(header + 8) != kVersion
+        || getU32(header + 12) != BinaryEventLog::kRecordBytes) {
+        std::fclose(f);
+        throw std::runtime_error("Not a binary event log: " + filename);
+    }
+
+    std::vector<unsigned char> buf(4096 * BinaryEventLog::kRecordBytes);
+    std::uint64_t count = 0;
+    std::size_t got;
+    while ((got = std::fread(buf.data(), 1, buf.size(), f)) > 0) {
+        const std::size_t n = got / BinaryEventLog::kRecordBytes;
+        for (std::size_t i = 0; i < n; ++i) {
+            fn(decode(buf.data() + i * BinaryEventLog::kRecordBytes));
+        }
+        count += n;
+    }
+    std::fclose(f);
+    return count;
+}
+
+std::uint64_t renderBinaryEventLog(const std::string& filename, std::ostream& out) {
+    return readBinaryEventLog(filename, [&out](const LogRecord& r) {
+        out << formatLogRecord(r) << '\n';
+    });
+}
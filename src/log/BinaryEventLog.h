@@ -0,0 +1,104 @@
+/**
+ * @file BinaryEventLog.h
+ * @brief Binary step log: lock-free ring buffer drained to a file by a background thread.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * BinaryEventLog log("run.pslog");
+ * sim.setLogSink(&log);
+ * q.run();
+ * log.close();                               // drain and flush
+ * renderBinaryEventLog("run.pslog", std::cout); // text only when needed
+ * @endcode
+ */
+#ifndef LOG_BINARYEVENTLOG_H
+#define LOG_BINARYEVENTLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log/LogSink.h"
+
+/**
+ * @brief LogSink that writes fixed-size binary records to a file.
+ * @details The simulation thread only copies the record into a single-producer /
+ *          single-consumer ring buffer. A background thread drains the buffer and
+ *          writes 24-byte little-endian records after a short file header. When
+ *          the ring is full the producer waits for the writer (no records are lost).
+ */
+class BinaryEventLog : public LogSink {
+public:
+    /// Size of one encoded record on disk.
+    static constexpr std::size_t kRecordBytes = 24;
+
+    /**
+     * @brief Open the output file and start the writer thread.
+     * @param filename Output path (truncated).
+     * @param ringCapacity Ring buffer size in records (rounded up to a power of two).
+     * @throws std::runtime_error if the file cannot be opened or written.
+     */
+    explicit BinaryEventLog(const std::string& filename, std::size_t ringCapacity = 1u << 16);
+    ~BinaryEventLog() override;
+
+    BinaryEventLog(const BinaryEventLog&) = delete;
+    BinaryEventLog& operator=(const BinaryEventLog&) = delete;
+
+    /** @brief Enqueue a record (simulation thread only); ignored once closed. */
+    void record(const LogRecord& r) override;
+
+    /**
+     * @brief Drain all pending records, stop the writer and close the file. Idempotent.
+     * @throws std::runtime_error if any write (or the final flush) failed, e.g. a full
+     *         disk; records after the failure are lost. The destructor reports it on
+     *         std::cerr instead.
+     */
+    void close();
+
+    /** @return Number of records handed to the log so far. */
+    std::uint64_t recordsWritten() const { return produced_; }
+
+private:
+    void writerLoop();
+    std::size_t drain();
+
+    std::vector<LogRecord> ring_;     ///< Ring storage.
+    std::size_t            mask_{0};  ///< ring_.size() - 1.
+
+    alignas(64) std::atomic<std::size_t> head_{0}; ///< Next slot to write (producer).
+    alignas(64) std::atomic<std::size_t> tail_{0}; ///< Next slot to read (consumer).
+    alignas(64) std::atomic<bool>        stop_{false};
+
+    std::uint64_t              produced_{0};
+    std::string                filename_;
+    std::FILE*                 file_{nullptr};   ///< Null once closed.
+    bool                       writeFailed_{false}; ///< Set by the writer thread; read after join.
+    std::vector<unsigned char> out_;   ///< Encoding buffer of the writer thread.
+    std::thread                writer_;
+};
+
+/**
+ * @brief Read a binary step log and call @p fn for every record.
+ * @param filename Log written by @ref BinaryEventLog.
+ * @param fn Callback per record, in emission order.
+ * @return Number of records read.
+ * @throws std::runtime_error if the file is missing or not a step log.
+ */
+std::uint64_t readBinaryEventLog(const std::string& filename,
+                                 const std::function<void(const LogRecord&)>& fn);
+
+/**
+ * @brief Render a binary step log as the usual text lines, one per record.
+ * @param filename Log written by @ref BinaryEventLog.
+ * @param out Stream receiving the text.
+ * @return Number of records rendered.
+ */
+std::uint64_t renderBinaryEventLog(const std::string& filename, std::ostream& out);
+
+#endif // LOG_BINARYEVENTLOG_H
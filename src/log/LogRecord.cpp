@@ -0,0 +1,49 @@
+/**
+ * @file LogRecord.cpp
+ * @brief Text rendering of simulation step records.
+ */
+#include "log/LogRecord.h"
+
+std::string formatLogRecord(const LogRecord& r) {
+    using std::to_string;
+    const std::string page  = to_string(r.page);
+    const std::string frame = to_string(r.frame);
+
+    switch (r.kind) {
+    case LogEventKind::Step:
+        return "--- Schritt " + to_string(r.step) + " (" + (r.write ? 'W' : 'R')
+             + "): Zugriff auf virtuelle Seite " + page + " ---";
+    case LogEventKind::NoProcess:
+        return "! Kein aktiver Prozess gesetzt.";
+    case LogEventKind::InvalidPage:
+        return "! Ungültige Seite " + page + " (0.." + to_string(r.aux)
+             + "). Zugriff ignoriert.";
+    case LogEventKind::TlbHit:
+        return "> TLB-Hit: Seite " + page + " -> Rahmen " + frame + ".";
+    case LogEventKind::DirtySet:
+        return "> Schreibzugriff: Dirty-Bit von Rahmen " + frame + " gesetzt.";
+    case LogEventKind::TlbMiss:
+        return "> TLB-Miss für Seite " + page + ".";
+    case LogEventKind::PageFault:
+        return "> Page-Fault für Seite " + page + " (nicht im Speicher).";
+    case LogEventKind::PageHit:
+        return "> Page-Hit: Seite " + page + " in Rahmen " + frame + ".";
+    case LogEventKind::TlbUpdate:
+        return "> TLB wird aktualisiert: Seite " + page + " -> Rahmen " + frame + ".";
+    case LogEventKind::FreeFrame:
+        return "! Physikalischer Speicher hat freien Rahmen " + frame
+             + ". Lade Seite " + page + " in Rahmen " + frame + ".";
+    case LogEventKind::Evict:
+        return "! Speicher voll. Ersetze Seite " + to_string(r.aux)
+             + " aus Rahmen " + frame + " gemäß Algorithmus.";
+    case LogEventKind::TlbInvalidate:
+        return "> TLB: Eintrag für Rahmen " + frame + " entfernt.";
+    case LogEventKind::FrameReleased:
+        return "> Rahmen " + frame + " freigegeben (Seite " + page + ").";
+    case LogEventKind::StlbHit:
+        return "> L2-TLB-Hit: Seite " + page + " -> Rahmen " + frame + ".";
+    case LogEventKind::ContextSwitch:
+        return "> Kontextwechsel zu Prozess " + to_string(r.aux) + " (ohne TLB-Flush).";
+    }
+    return {};
+}
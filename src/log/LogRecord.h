@@ -0,0 +1,55 @@
+/**
+ * @file LogRecord.h
+ * @brief Compact, unformatted description of one simulation step message.
+ *
+ * The simulation core never builds log text itself. It fills a small
+ * @ref LogRecord and hands it to the attached sinks; the German UI text is
+ * only produced by @ref formatLogRecord when a text sink actually asks for it.
+ */
+#ifndef LOG_LOGRECORD_H
+#define LOG_LOGRECORD_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Kind of a step message emitted by the simulation.
+ */
+enum class LogEventKind : std::uint8_t {
+    Step,          ///< Header of a new access ("Schritt N").
+    NoProcess,     ///< No active process set; access ignored.
+    InvalidPage,   ///< Page outside the page table; aux = highest valid page.
+    TlbHit,        ///< TLB hit: page -> frame.
+    DirtySet,      ///< Write access set the dirty bit of frame.
+    TlbMiss,       ///< TLB miss for page.
+    PageFault,     ///< Page fault for page.
+    PageHit,       ///< Page found in RAM (frame).
+    TlbUpdate,     ///< TLB updated with page -> frame.
+    FreeFrame,     ///< Page is loaded into free frame.
+    Evict,         ///< Memory full; aux = evicted page, frame = its frame.
+    TlbInvalidate, ///< TLB entry for frame removed.
+    FrameReleased, ///< Frame released explicitly (page unmapped, frame free again).
+    StlbHit,       ///< L1 TLB missed, second-level TLB hit: page -> frame.
+    ContextSwitch  ///< Switched to table process aux (ASID change, no TLB flush).
+};
+
+/**
+ * @brief One step message in raw form (no strings, no allocation).
+ */
+struct LogRecord {
+    std::uint64_t step{0};     ///< Step counter of the access ("Schritt N").
+    std::int32_t  page{-1};    ///< Virtual page concerned.
+    std::int32_t  frame{-1};   ///< Physical frame concerned (-1 if none).
+    std::int32_t  aux{-1};     ///< Kind-specific extra value (see @ref LogEventKind).
+    LogEventKind  kind{LogEventKind::Step}; ///< What happened.
+    bool          write{false};             ///< Access type of the step (W/R).
+};
+
+/**
+ * @brief Render a record as the human-readable UI line.
+ * @param r Record to format.
+ * @return The same German one-line text the simulation used to emit directly.
+ */
+std::string formatLogRecord(const LogRecord& r);
+
+#endif // LOG_LOGRECORD_H
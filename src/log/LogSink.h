@@ -0,0 +1,26 @@
+/**
+ * @file LogSink.h
+ * @brief Interface for consumers of raw simulation step records.
+ */
+#ifndef LOG_LOGSINK_H
+#define LOG_LOGSINK_H
+
+#include "log/LogRecord.h"
+
+/**
+ * @brief Receives every @ref LogRecord emitted by a Simulation.
+ * @details Called synchronously on the simulation thread, so implementations
+ *          should be cheap (e.g. copy the record into a buffer).
+ */
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief Consume one record.
+     * @param r Record describing one step message.
+     */
+    virtual void record(const LogRecord& r) = 0;
+};
+
+#endif // LOG_LOGSINK_H
@@ -0,0 +1,11 @@
+/**
+ * @file ClockSimulation.cpp
+ * @brief Statically bound simulation with CLOCK replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/ClockAlgorithm.h"
+
+template class BasicSimulation<ClockAlgorithm>;
@@ -0,0 +1,11 @@
+/**
+ * @file FIFOSimulation.cpp
+ * @brief Statically bound simulation with FIFO replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/FIFOAlgorithm.h"
+
+template class BasicSimulation<FIFOAlgorithm>;
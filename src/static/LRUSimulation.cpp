@@ -0,0 +1,11 @@
+/**
+ * @file LRUSimulation.cpp
+ * @brief Statically bound simulation with LRU replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/LRUAlgorithm.h"
+
+template class BasicSimulation<LRUAlgorithm>;
@@ -0,0 +1,11 @@
+/**
+ * @file NFUNoAgingSimulation.cpp
+ * @brief Statically bound simulation with NFU (no aging) replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/NFUNoAgingAlgorithm.h"
+
+template class BasicSimulation<NFUNoAgingAlgorithm>;
@@ -0,0 +1,11 @@
+/**
+ * @file NFUSimulation.cpp
+ * @brief Statically bound simulation with NFU replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/NFUAlgorithm.h"
+
+template class BasicSimulation<NFUAlgorithm>;
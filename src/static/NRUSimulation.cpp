@@ -0,0 +1,11 @@
+/**
+ * @file NRUSimulation.cpp
+ * @brief Statically bound simulation with NRU replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/NRUAlgorithm.h"
+
+template class BasicSimulation<NRUAlgorithm>;
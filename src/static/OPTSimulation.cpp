@@ -0,0 +1,11 @@
+/**
+ * @file OPTSimulation.cpp
+ * @brief Statically bound simulation with OPT replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/OPTAlgorithm.h"
+
+template class BasicSimulation<OPTAlgorithm>;
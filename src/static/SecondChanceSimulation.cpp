@@ -0,0 +1,11 @@
+/**
+ * @file SecondChanceSimulation.cpp
+ * @brief Statically bound simulation with Second-Chance replacement.
+ *
+ * One specialization per unit, so the compiler's unit growth budget goes
+ * to inlining this algorithm's hooks into the access path.
+ */
+#include "Simulation.h"
+#include "core/algorithms/SecondChanceAlgorithm.h"
+
+template class BasicSimulation<SecondChanceAlgorithm>;
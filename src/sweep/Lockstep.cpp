@@ -0,0 +1,150 @@
+/**
+ * @file Lockstep.cpp
+ * @brief Implementation of the single-pass multi-simulation driver.
+ */
+#include "sweep/Lockstep.h"
+
+#include <algorithm>
+#include <barrier>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <thread>
+#include <utility>
+
+void LockstepRunner::add(std::string name, std::unique_ptr<Simulation> sim) {
+    names_.push_back(std::move(name));
+    sims_.push_back(std::move(sim));
+}
+
+void LockstepRunner::addNewProcesses(const std::vector<MemoryAccessEvent>& chunk) {
+    for (const auto& ev : chunk) {
+        const unsigned char id = ev.processId();
+        if (seen_[id]) continue;
+        seen_[id] = true;
+        for (auto& sim : sims_) {
+            if (!sim->process(id)) sim->addProcess(id, pagesPerProcess_, kind_);
+        }
+    }
+}
+
+std::size_t LockstepRunner::run(TraceSource& source, std::size_t chunkSize, unsigned threads) {
+    if (chunkSize == 0) chunkSize = 1;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, sims_.size())));
+
+    std::vector<MemoryAccessEvent> buffers[2];
+    buffers[0].reserve(chunkSize);
+    buffers[1].reserve(chunkSize);
+    std::size_t total = 0;
+
+    if (threads == 1) {
+        while (source.next(buffers[0], chunkSize) > 0) {
+            addNewProcesses(buffers[0]);
+            for (auto& sim : sims_) sim->runBatch(buffers[0]);
+            total += buffers[0].size();
+            buffers[0].clear();
+        }
+        return total;
+    }
+
+    // Two barrier phases per chunk: "start" publishes buffers[current] to the
+    // workers, "done" waits until all of them have replayed it. Between the
+    // two, the calling thread decodes the next chunk into the other buffer.
+    std::barrier<>                  sync(static_cast<std::ptrdiff_t>(threads) + 1);
+    int                             current  = 0;
+    bool                            finished = false;
+    std::vector<std::exception_ptr> workerErrors(threads);
+
+    auto worker = [&](unsigned self) {
+        for (;;) {
+            sync.arrive_and_wait(); // start
+            if (finished) return;
+            if (!workerErrors[self]) {
+                try {
+                    for (std::size_t i = self; i < sims_.size(); i += threads) {
+                        sims_[i]->runBatch(buffers[current]);
+                    }
+                } catch (...) {
+                    workerErrors[self] = std::current_exception();
+                }
+            }
+            sync.arrive_and_wait(); // done
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned w = 0; w < threads; ++w) workers.emplace_back(worker, w);
+
+    std::exception_ptr mainError;
+    try {
+        source.next(buffers[current], chunkSize);
+        addNewProcesses(buffers[current]);
+    } catch (...) {
+        mainError = std::current_exception();
+        buffers[current].clear();
+    }
+    while (!buffers[current].empty()) {
+        sync.arrive_and_wait(); // start
+        total += buffers[current].size();
+        auto& next = buffers[1 - current];
+        next.clear();
+        try {
+            source.next(next, chunkSize);
+        } catch (...) {
+            mainError = std::current_exception();
+            next.clear();
+        }
+        sync.arrive_and_wait(); // done
+        // Workers are parked at "start" now, so the simulations may be changed.
+        try {
+            if (!mainError) addNewProcesses(next);
+        } catch (...) {
+            mainError = std::current_exception();
+            next.clear();
+        }
+        current = 1 - current;
+    }
+    finished = true;
+    sync.arrive_and_wait(); // release the workers
+    for (auto& t : workers) t.join();
+
+    if (mainError) std::rethrow_exception(mainError);
+    for (auto& e : workerErrors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return total;
+}
+
+void LockstepRunner::writeTable(std::ostream& os) const {
+    std::vector<Simulation::Stats> stats;
+    stats.reserve(sims_.size());
+    for (const auto& sim : sims_) stats.push_back(sim->stats());
+
+    std::size_t width = 12;
+    for (const auto& n : names_) width = std::max(width, n.size() + 2);
+
+    const auto row = [&](const char* label, const std::function<void(const Simulation::Stats&)>& cell) {
+        os << std::left << std::setw(16) << label << std::right;
+        for (const auto& s : stats) {
+            os << std::setw(static_cast<int>(width));
+            cell(s);
+        }
+        os << "\n";
+    };
+    os << std::left << std::setw(16) << "" << std::right;
+    for (const auto& n : names_) os << std::setw(static_cast<int>(width)) << n;
+    os << "\n";
+    row("Accesses",        [&](const auto& s) { os << s.accesses; });
+    row("TLB hits",        [&](const auto& s) { os << s.tlbHits; });
+    row("TLB misses",      [&](const auto& s) { os << s.tlbMisses; });
+    row("TLB hit %",       [&](const auto& s) { os << s.tlbHitRate * 100.0; });
+    row("L2 TLB hits",     [&](const auto& s) { os << s.l2TlbHits; });
+    row("Page faults",     [&](const auto& s) { os << s.pageFaults; });
+    row("Fault %",         [&](const auto& s) { os << s.pageFaultRate * 100.0; });
+    row("Avg time (us)",   [&](const auto& s) { os << s.avgAccessTimeUs; });
+    row("Walk levels",     [&](const auto& s) { os << s.pageWalkLevels; });
+    row("Ctx switches",    [&](const auto& s) { os << s.contextSwitches; });
+}
@@ -0,0 +1,96 @@
+/**
+ * @file Lockstep.h
+ * @brief Several simulations driven by a single pass over a trace.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * LockstepRunner runner;
+ * for (const auto& name : pagingAlgorithmNames()) {
+ *     runner.add(name, std::make_unique<Simulation>(64, makePagingAlgorithm(name), 16));
+ * }
+ * auto source = openTrace("trace.bin");
+ * runner.run(*source, 4096, 4);          // 4 threads, one barrier per chunk
+ * runner.writeTable(std::cout);
+ * @endcode
+ */
+#ifndef SWEEP_LOCKSTEP_H
+#define SWEEP_LOCKSTEP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+#include "core/PageTable.h"
+#include "trace/TraceSource.h"
+
+/**
+ * @brief Feeds every decoded chunk of a trace to N simulations in turn.
+ * @details The trace is read once. Each chunk (a few thousand accesses) is
+ *          replayed by all simulations while it is still in cache, so reading
+ *          and parsing cost is paid once instead of N times.
+ *
+ *          With more than one thread, the simulations are dealt round-robin
+ *          to the workers. The chunk boundary is a barrier: workers replay
+ *          chunk k while the calling thread decodes chunk k+1 into a second
+ *          buffer, and nobody moves on until every simulation has finished
+ *          chunk k. Each simulation still sees the accesses in trace order,
+ *          so the results are the same for any thread count.
+ *
+ *          Processes are added to a simulation when their ID first appears,
+ *          unless the simulation already has a process with that ID.
+ */
+class LockstepRunner {
+public:
+    /**
+     * @param pagesPerProcess Page-table size of processes added on first sight.
+     * @param kind            Their page-table layout (radix for large, sparse traces).
+     */
+    explicit LockstepRunner(std::uint64_t pagesPerProcess = 1 << 16,
+                            PageTableKind kind = PageTableKind::Dense)
+        : pagesPerProcess_(pagesPerProcess), kind_(kind) {}
+
+    /** @brief Add a simulation under a column name. */
+    void add(std::string name, std::unique_ptr<Simulation> sim);
+
+    /**
+     * @brief Replay the whole source through every simulation.
+     * @param source    Stream of accesses (consumed).
+     * @param chunkSize Accesses decoded per chunk.
+     * @param threads   Worker threads; 1 runs everything on the calling
+     *                  thread, 0 uses one per simulation (capped at the
+     *                  hardware threads).
+     * @return Number of accesses replayed.
+     * @throws The first exception thrown by a simulation, after the trace
+     *         has been drained.
+     */
+    std::size_t run(TraceSource& source, std::size_t chunkSize = 4096, unsigned threads = 1);
+
+    /** @return Number of simulations. */
+    std::size_t size() const { return sims_.size(); }
+    /** @return Column name of simulation @p i. */
+    const std::string& name(std::size_t i) const { return names_[i]; }
+    /** @return Simulation @p i. */
+    Simulation& simulation(std::size_t i) { return *sims_[i]; }
+
+    /**
+     * @brief Print the statistics side by side: one row per counter, one
+     *        column per simulation.
+     */
+    void writeTable(std::ostream& os) const;
+
+private:
+    /** @brief Add table processes for process IDs seen for the first time. */
+    void addNewProcesses(const std::vector<MemoryAccessEvent>& chunk);
+
+    std::vector<std::string>                 names_;
+    std::vector<std::unique_ptr<Simulation>> sims_;
+    std::uint64_t                            pagesPerProcess_;
+    PageTableKind                            kind_;
+    bool                                     seen_[256]{};
+};
+
+#endif // SWEEP_LOCKSTEP_H
@@ -0,0 +1,129 @@
+/**
+ * @file Sweep.cpp
+ * @brief Implementation of the parallel parameter sweep.
+ */
+#include "sweep/Sweep.h"
+
+#include <chrono>
+#include <ostream>
+
+#include "core/AddressSpace.h"
+#include "sweep/WorkStealingPool.h"
+
+namespace {
+
+const char* replacementName(TLBReplacement r) {
+    switch (r) {
+    case TLBReplacement::FIFO:   return "fifo";
+    case TLBReplacement::LRU:    return "lru";
+    case TLBReplacement::Random: return "random";
+    case TLBReplacement::PLRU:   return "plru";
+    }
+    return "?";
+}
+
+} // namespace
+
+SharedTrace SharedTrace::decode(TraceSource& source, std::uint64_t pageBytes) {
+    SharedTrace trace;
+    trace.pageBytes_ = pageBytes;
+    trace.processes_.resize(256);
+    std::vector<AddressSpace> spaces(256, AddressSpace(pageBytes));
+
+    constexpr std::size_t kChunk = 1 << 16;
+    std::size_t begin = 0;
+    while (source.next(trace.events_, kChunk) > 0) {
+        for (std::size_t i = begin; i < trace.events_.size(); ++i) {
+            const MemoryAccessEvent& ev = trace.events_[i];
+            ProcessInfo& p = trace.processes_[ev.processId()];
+            p.used = true;
+            int page = ev.pageId();
+            if (ev.isAddress()) {
+                p.address = true;
+                page = spaces[ev.processId()].translate(ev.address());
+            }
+            if (page >= 0 && std::uint64_t(page) >= p.pages) p.pages = std::uint64_t(page) + 1;
+        }
+        begin = trace.events_.size();
+    }
+    trace.events_.shrink_to_fit();
+    return trace;
+}
+
+template <class Sim>
+void SharedTrace::addProcesses(Sim& sim) const {
+    for (std::size_t id = 0; id < processes_.size(); ++id) {
+        const ProcessInfo& info = processes_[id];
+        if (!info.used) continue;
+        Process& p = sim.addProcess(static_cast<unsigned char>(id), info.pages ? info.pages : 1);
+        if (info.address) p.address_space = AddressSpace(pageBytes_);
+    }
+}
+
+void SharedTrace::setUp(Simulation& sim) const { addProcesses(sim); }
+
+void SharedTrace::setUp(SimulationRunner& sim) const { addProcesses(sim); }
+
+std::vector<SweepConfig> sweepGrid(const std::vector<std::string>& algorithms,
+                                   const std::vector<int>& frames,
+                                   const std::vector<TLBConfig>& tlbs) {
+    std::vector<SweepConfig> configs;
+    configs.reserve(algorithms.size() * frames.size() * tlbs.size());
+    for (const auto& a : algorithms) {
+        for (int f : frames) {
+            for (const auto& t : tlbs) configs.push_back(SweepConfig{a, f, t});
+        }
+    }
+    return configs;
+}
+
+std::vector<SweepResult> runSweep(const SharedTrace& trace,
+                                  std::span<const SweepConfig> configs,
+                                  unsigned threads) {
+    // Every task writes only its own slot; the trace is only read.
+    std::vector<SweepResult> results(configs.size());
+    WorkStealingPool pool(threads);
+    for (std::size_t i = 0; i < configs.size(); ++i) {
+        pool.submit([&trace, &configs, &results, i] {
+            const SweepConfig& cfg = configs[i];
+            auto sim = makeStaticSimulation(cfg.algorithm, cfg.frames, cfg.tlb);
+            trace.setUp(*sim);
+            const auto start = std::chrono::steady_clock::now();
+            sim->runBatch(trace.events());
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            results[i] = SweepResult{cfg, sim->stats(), elapsed.count()};
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+void writeSweepCsv(std::ostream& os, std::span<const SweepResult> results) {
+    os << "algorithm,frames,tlb_entries,tlb_ways,tlb_policy,accesses,tlb_hits,tlb_misses,"
+          "page_faults,tlb_hit_rate,page_fault_rate,avg_access_time_us,seconds\n";
+    for (const auto& r : results) {
+        const auto& s = r.stats;
+        os << r.config.algorithm << ',' << r.config.frames << ',' << r.config.tlb.capacity << ','
+           << r.config.tlb.ways << ',' << replacementName(r.config.tlb.replacement) << ','
+           << s.accesses << ',' << s.tlbHits << ',' << s.tlbMisses << ',' << s.pageFaults << ','
+           << s.tlbHitRate << ',' << s.pageFaultRate << ',' << s.avgAccessTimeUs << ','
+           << r.seconds << '\n';
+    }
+}
+
+void writeSweepJson(std::ostream& os, std::span<const SweepResult> results) {
+    os << "[\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        const auto& s = r.stats;
+        os << "  {\"algorithm\": \"" << r.config.algorithm << "\", \"frames\": " << r.config.frames
+           << ", \"tlb_entries\": " << r.config.tlb.capacity << ", \"tlb_ways\": " << r.config.tlb.ways
+           << ", \"tlb_policy\": \"" << replacementName(r.config.tlb.replacement) << "\""
+           << ", \"accesses\": " << s.accesses << ", \"tlb_hits\": " << s.tlbHits
+           << ", \"tlb_misses\": " << s.tlbMisses << ", \"page_faults\": " << s.pageFaults
+           << ", \"tlb_hit_rate\": " << s.tlbHitRate << ", \"page_fault_rate\": " << s.pageFaultRate
+           << ", \"avg_access_time_us\": " << s.avgAccessTimeUs << ", \"seconds\": " << r.seconds
+           << (i + 1 < results.size() ? "},\n" : "}\n");
+    }
+    os << "]\n";
+}
@@ -0,0 +1,116 @@
+/**
+ * @file Sweep.h
+ * @brief Parameter sweeps: one decoded trace replayed by many simulations in parallel.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * auto source = openTrace("trace.bin");
+ * const SharedTrace trace = SharedTrace::decode(*source);
+ * auto configs  = sweepGrid({"lru", "fifo"}, {64, 256}, {TLBConfig{16}, TLBConfig{64}});
+ * auto results  = runSweep(trace, configs);      // all hardware threads
+ * writeSweepCsv(std::cout, results);
+ * @endcode
+ */
+#ifndef SWEEP_SWEEP_H
+#define SWEEP_SWEEP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+#include "SimulationRegistry.h"
+#include "core/MemoryAccessEvent.h"
+#include "core/TLB.h"
+#include "trace/TraceSource.h"
+
+/**
+ * @brief A whole trace decoded into memory, read-only and shared by all runs.
+ * @details Decoding also records, per process ID, how many page IDs the
+ *          trace needs, so every simulation can set up identical table
+ *          processes with @ref setUp. Address accesses are sized by
+ *          translating them once with an AddressSpace of the given page size;
+ *          the simulations' own address spaces hand out the same IDs.
+ */
+class SharedTrace {
+public:
+    /**
+     * @brief Read a trace source to the end.
+     * @param source    Stream of accesses (consumed).
+     * @param pageBytes Base page size for address accesses (4, 16 or 64 KiB).
+     * @throws std::invalid_argument for an unsupported page size.
+     */
+    static SharedTrace decode(TraceSource& source, std::uint64_t pageBytes = 4096);
+
+    /** @return All accesses, in trace order. */
+    std::span<const MemoryAccessEvent> events() const { return events_; }
+
+    /**
+     * @brief Add one table process per process ID of the trace to @p sim.
+     * @throws std::invalid_argument if @p sim already has one of the processes
+     *         (see Simulation::addProcess).
+     */
+    void setUp(Simulation& sim) const;
+    /** @overload */
+    void setUp(SimulationRunner& sim) const;
+
+private:
+    template <class Sim>
+    void addProcesses(Sim& sim) const;
+
+    struct ProcessInfo {
+        std::uint64_t pages{0};     ///< Highest page ID used + 1.
+        bool          used{false};
+        bool          address{false};
+    };
+
+    std::vector<MemoryAccessEvent> events_;
+    std::vector<ProcessInfo>       processes_; ///< Indexed by process ID.
+    std::uint64_t                  pageBytes_{4096};
+};
+
+/** @brief One simulation of a sweep. */
+struct SweepConfig {
+    std::string algorithm;  ///< Name accepted by @ref makePagingAlgorithm.
+    int         frames{0};  ///< Physical frames.
+    TLBConfig   tlb;        ///< TLB shape (capacity 0 disables it).
+};
+
+/** @brief Outcome of one sweep configuration. */
+struct SweepResult {
+    SweepConfig       config;
+    Simulation::Stats stats;
+    double            seconds{0}; ///< Wall time of the replay.
+};
+
+/** @return Cartesian product algorithms x frames x TLBs, in that nesting order. */
+std::vector<SweepConfig> sweepGrid(const std::vector<std::string>& algorithms,
+                                   const std::vector<int>& frames,
+                                   const std::vector<TLBConfig>& tlbs);
+
+/**
+ * @brief Replay the trace once per configuration on a work-stealing pool.
+ * @details Each task builds its own statically bound simulation
+ *          (@ref makeStaticSimulation) and replays the shared events in
+ *          place (no per-thread copy). Results come back in the
+ *          order of @p configs regardless of which thread ran them.
+ * @param trace   Decoded trace.
+ * @param configs Configurations to run.
+ * @param threads Worker threads; 0 uses all hardware threads.
+ * @throws The first exception of a run (e.g. an unknown algorithm name).
+ */
+std::vector<SweepResult> runSweep(const SharedTrace& trace,
+                                  std::span<const SweepConfig> configs,
+                                  unsigned threads = 0);
+
+/** @brief Write results as CSV with a header line. */
+void writeSweepCsv(std::ostream& os, std::span<const SweepResult> results);
+
+/** @brief Write results as a JSON array of objects. */
+void writeSweepJson(std::ostream& os, std::span<const SweepResult> results);
+
+#endif // SWEEP_SWEEP_H
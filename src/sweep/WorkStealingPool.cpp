@@ -0,0 +1,94 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the work-stealing thread pool.
+ */
+#include "sweep/WorkStealingPool.h"
+
+#include <utility>
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    queues_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) workers_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::unique_lock lock(m_);
+        idle_.wait(lock, [this] { return pending_ == 0; });
+        stop_ = true;
+    }
+    work_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    // Counted before it is visible, so a worker never takes an uncounted task
+    // (a worker that wakes first just retries until the push lands).
+    std::size_t target;
+    {
+        std::lock_guard lock(m_);
+        target = next_++ % queues_.size();
+        ++pending_;
+        ++queued_;
+    }
+    {
+        std::lock_guard lock(queues_[target]->m);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    work_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock lock(m_);
+    idle_.wait(lock, [this] { return pending_ == 0; });
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+bool WorkStealingPool::tryTake(unsigned self, std::function<void()>& task) {
+    // Own deque from the back (most recently queued), others from the front.
+    const std::size_t n = queues_.size();
+    for (std::size_t k = 0; k < n; ++k) {
+        Queue& q = *queues_[(self + k) % n];
+        std::lock_guard lock(q.m);
+        if (q.tasks.empty()) continue;
+        if (k == 0) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(unsigned self) {
+    std::function<void()> task;
+    for (;;) {
+        if (tryTake(self, task)) {
+            {
+                std::lock_guard lock(m_);
+                --queued_;
+            }
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            task = nullptr;
+            std::lock_guard lock(m_);
+            if (error && !error_) error_ = error;
+            if (--pending_ == 0) idle_.notify_all();
+            continue;
+        }
+        std::unique_lock lock(m_);
+        work_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0) return;
+    }
+}
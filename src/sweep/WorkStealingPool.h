@@ -0,0 +1,81 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Fixed set of worker threads with per-worker task deques and stealing.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * WorkStealingPool pool;                 // one worker per hardware thread
+ * for (auto& cfg : configs) pool.submit([&cfg] { run(cfg); });
+ * pool.wait();                           // rethrows the first task exception
+ * @endcode
+ */
+#ifndef SWEEP_WORKSTEALINGPOOL_H
+#define SWEEP_WORKSTEALINGPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread pool for coarse, independent tasks.
+ * @details Submitted tasks are dealt round-robin onto the workers' deques.
+ *          A worker runs its own tasks newest first and, once its deque is
+ *          empty, steals the oldest task of another worker, so uneven task
+ *          lengths do not leave threads idle while work remains. Each deque
+ *          has its own lock; the pool-wide lock is only taken to count tasks
+ *          and to sleep, which is cheap for tasks that run for milliseconds
+ *          or more.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Start the workers.
+     * @param threads Number of workers; 0 uses std::thread::hardware_concurrency().
+     */
+    explicit WorkStealingPool(unsigned threads = 0);
+    /** @brief Finish all submitted tasks, then stop and join the workers. */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /** @brief Queue a task. Safe to call from any thread, including a task. */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Block until every submitted task has finished.
+     * @throws The first exception thrown by a task since the last wait().
+     */
+    void wait();
+
+    /** @return Number of worker threads. */
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+private:
+    struct Queue {
+        std::mutex                        m;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(unsigned self);
+    bool tryTake(unsigned self, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread>            workers_;
+    std::mutex                          m_;        ///< Guards the counters below.
+    std::condition_variable             work_;     ///< Signalled when tasks are queued or on stop.
+    std::condition_variable             idle_;     ///< Signalled when the last task finishes.
+    std::size_t                         queued_{0};  ///< Tasks in the deques.
+    std::size_t                         pending_{0}; ///< Tasks submitted and not finished.
+    std::size_t                         next_{0};    ///< Round-robin deque for submit().
+    bool                                stop_{false};
+    std::exception_ptr                  error_;
+};
+
+#endif // SWEEP_WORKSTEALINGPOOL_H
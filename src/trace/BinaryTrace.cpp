@@ -0,0 +1,250 @@
+/**
+ * @file BinaryTrace.cpp
+ * @brief Implementation of the binary trace writer and reader.
+ */
+#include "trace/BinaryTrace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char          kMagic[8] = {'P', 'S', 'T', 'R', 'A', 'C', 'E', '\0'};
+constexpr std::uint32_t kVersion  = 3;   ///< Written; adds the address bit.
+constexpr std::uint32_t kVersion2 = 2;   ///< Still read: process-ID bit, page IDs only.
+constexpr std::uint32_t kVersion1 = 1;   ///< Still read: page deltas and W only.
+constexpr std::size_t   kHeaderBytes = 24;
+constexpr std::size_t   kMaxVarintBytes = 10; ///< 64-bit delta plus 3 flag bits.
+constexpr std::size_t   kMaxAccessBytes = kMaxVarintBytes + 1; ///< Varint plus process byte.
+
+void putU32(unsigned char* p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+void putU64(unsigned char* p, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+std::uint32_t getU32(const unsigned char* p) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= std::uint32_t(p[i]) << (8 * i);
+    return v;
+}
+std::uint64_t getU64(const unsigned char* p) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= std::uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+inline std::int64_t unzigzag(std::uint64_t v) {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+} // namespace
+
+// ---------------- Writer ----------------
+
+BinaryTraceWriter::BinaryTraceWriter(const std::string& filename, std::uint32_t blockAccesses)
+    : filename_(filename), blockAccesses_(blockAccesses ? blockAccesses : 1)
+{
+    file_ = std::fopen(filename.c_str(), "wb");
+    if (!file_) throw std::runtime_error("Cannot create trace file: " + filename);
+
+    unsigned char header[kHeaderBytes];
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    putU32(header + 8,  kVersion);
+    putU32(header + 12, blockAccesses_);
+    putU64(header + 16, 0); // patched in close()
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        std::fclose(file_);
+        file_ = nullptr;
+        throw std::runtime_error("Write error on trace file: " + filename);
+    }
+
+    block_.resize(std::size_t(blockAccesses_) * kMaxAccessBytes);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n'; // destructors must not throw; call close() to handle it
+    }
+}
+
+void BinaryTraceWriter::addTarget(std::uint64_t target, bool address, bool write,
+                                  unsigned char processId) {
+    unsigned char* p = block_.data() + blockBytes_;
+    blockBytes_ = static_cast<std::size_t>(encode(p, target, address, write, processId) - block_.data());
+    ++total_;
+    if (++blockCount_ == blockAccesses_) flushBlock();
+}
+
+void BinaryTraceWriter::add(std::span<const MemoryAccessEvent> events) {
+    std::size_t i = 0;
+    while (i < events.size()) {
+        // The buffer holds a full block of worst-case accesses, so no checks per access.
+        const std::size_t n = std::min<std::size_t>(events.size() - i, blockAccesses_ - blockCount_);
+        unsigned char* p = block_.data() + blockBytes_;
+        for (const auto& ev : events.subspan(i, n)) {
+            p = encode(p, ev.address(), ev.isAddress(), ev.write(), ev.processId());
+        }
+        blockBytes_ = static_cast<std::size_t>(p - block_.data());
+        blockCount_ += static_cast<std::uint32_t>(n);
+        total_      += n;
+        i           += n;
+        if (blockCount_ == blockAccesses_) flushBlock();
+    }
+}
+
+void BinaryTraceWriter::flushBlock() {
+    if (blockCount_ == 0) return;
+    unsigned char hdr[8];
+    putU32(hdr,     static_cast<std::uint32_t>(blockBytes_));
+    putU32(hdr + 4, blockCount_);
+    // Sticky: after a short write the file is unusable, so later blocks are dropped.
+    if (!writeFailed_
+        && (std::fwrite(hdr, 1, sizeof(hdr), file_) != sizeof(hdr)
+            || std::fwrite(block_.data(), 1, blockBytes_, file_) != blockBytes_)) {
+        writeFailed_ = true;
+    }
+    blockBytes_  = 0;
+    blockCount_  = 0;
+    prevTarget_  = 0;
+    prevProcess_ = 0;
+}
+
+void BinaryTraceWriter::close() {
+    if (!file_) return;
+    flushBlock();
+    unsigned char total[8];
+    putU64(total, total_);
+    if (!writeFailed_
+        && (std::fseek(file_, 16, SEEK_SET) != 0 || std::fwrite(total, 1, sizeof(total), file_) != sizeof(total))) {
+        writeFailed_ = true;
+    }
+    const bool closeFailed = std::fclose(file_) != 0; // buffered data is flushed here
+    file_ = nullptr;
+    if (writeFailed_ || closeFailed) throw std::runtime_error("Write error on trace file: " + filename_);
+}
+
+// ---------------- Reader ----------------
+
+BinaryTraceReader::BinaryTraceReader(const std::string& filename) : filename_(filename) {
+    file_ = std::fopen(filename.c_str(), "rb");
+    if (!file_) throw std::runtime_error("Cannot open trace file: " + filename);
+
+    unsigned char header[kHeaderBytes];
+    if (std::fread(header, 1, sizeof(header), file_) != sizeof(header)
+        || std::memcmp(header, kMagic, sizeof(kMagic)) != 0
+        || getU32(header + 8) < kVersion1 || getU32(header + 8) > kVersion) {
+        std::fclose(file_);
+        file_ = nullptr;
+        throw std::runtime_error("Not a binary trace: " + filename);
+    }
+    version_ = getU32(header + 8);
+    total_   = getU64(header + 16);
+    nextBlockOffset_ = kHeaderBytes;
+}
+
+BinaryTraceReader::~BinaryTraceReader() {
+    if (file_) std::fclose(file_);
+}
+
+bool BinaryTraceReader::isBinaryTrace(const std::string& filename) {
+    std::FILE* f = std::fopen(filename.c_str(), "rb");
+    if (!f) return false;
+    char magic[sizeof(kMagic)];
+    const bool ok = std::fread(magic, 1, sizeof(magic), f) == sizeof(magic)
+                 && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+    std::fclose(f);
+    return ok;
+}
+
+bool BinaryTraceReader::loadBlock() {
+    unsigned char hdr[8];
+    blockOffset_ = nextBlockOffset_;
+    if (std::fread(hdr, 1, sizeof(hdr), file_) != sizeof(hdr)) return false;
+    const std::uint32_t bytes = getU32(hdr);
+    remaining_ = getU32(hdr + 4);
+    nextBlockOffset_ += sizeof(hdr) + bytes;
+
+    // Every access takes 1 .. kMaxAccessBytes bytes.
+    if (remaining_ > bytes || bytes > std::uint64_t(remaining_) * kMaxAccessBytes) {
+        corrupt("access count does not fit the payload size");
+    }
+    // Slack so the decoder may read one full access past the payload without checks.
+    block_.resize(std::size_t(bytes) + kMaxAccessBytes);
+    if (std::fread(block_.data(), 1, bytes, file_) != bytes) {
+        throw std::runtime_error("Truncated binary trace block at offset " + std::to_string(blockOffset_)
+                                 + ": " + filename_);
+    }
+    std::memset(block_.data() + bytes, 0, kMaxAccessBytes);
+    pos_ = block_.data();
+    end_ = block_.data() + bytes;
+    prevTarget_  = 0;
+    prevProcess_ = 0;
+    return true;
+}
+
+template <int kFlagBits>
+std::size_t BinaryTraceReader::decode(std::vector<MemoryAccessEvent>& out, std::size_t take) {
+    const unsigned char* p = pos_;
+    std::uint64_t target  = prevTarget_;
+    unsigned char process = prevProcess_;
+    for (std::size_t i = 0; i < take; ++i) {
+        // An access starting inside the payload ends within the slack (the
+        // varint is capped below), so one check per access bounds all reads.
+        if (p >= end_) [[unlikely]] corrupt("accesses run past the payload");
+        // The low kFlagBits of the varint are flags, the rest is the zigzag delta.
+        std::uint64_t b = *p++;
+        const unsigned int flags = static_cast<unsigned int>(b) & ((1u << kFlagBits) - 1);
+        std::uint64_t z = (b & 0x7f) >> kFlagBits;
+        if (b >= 0x80) {
+            int shift = 7 - kFlagBits;
+            do {
+                // Byte j (j >= 1) lands at shift 7j - kFlagBits; byte 10 is the last allowed.
+                if (shift > 63 - kFlagBits) [[unlikely]] corrupt("varint longer than 10 bytes");
+                b = *p++;
+                z |= (b & 0x7f) << shift;
+                shift += 7;
+            } while (b >= 0x80);
+        }
+        if constexpr (kFlagBits >= 2) {
+            if (flags & 2) process = *p++;
+        }
+        target += static_cast<std::uint64_t>(unzigzag(z));
+        if (kFlagBits >= 3 && (flags & 4)) {
+            out.push_back(MemoryAccessEvent::atAddress(target, (flags & 1) != 0, process));
+        } else {
+            out.emplace_back(static_cast<int>(target), (flags & 1) != 0, process);
+        }
+    }
+    if (p > end_) corrupt("accesses run past the payload");
+    pos_         = p;
+    prevTarget_  = target;
+    prevProcess_ = process;
+    return take;
+}
+
+void BinaryTraceReader::corrupt(const char* what) const {
+    throw std::runtime_error("Corrupt binary trace block at offset " + std::to_string(blockOffset_)
+                             + " (" + what + "): " + filename_);
+}
+
+std::size_t BinaryTraceReader::next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) {
+    std::size_t n = 0;
+    while (n < maxCount) {
+        if (remaining_ == 0 && !loadBlock()) break;
+
+        const std::size_t take = std::min<std::size_t>(remaining_, maxCount - n);
+        switch (version_) {
+        case kVersion1: decode<1>(out, take); break;
+        case kVersion2: decode<2>(out, take); break;
+        default:        decode<3>(out, take); break;
+        }
+        remaining_ -= static_cast<std::uint32_t>(take);
+        n += take;
+    }
+    return n;
+}
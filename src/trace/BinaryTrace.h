@@ -0,0 +1,179 @@
+/**
+ * @file BinaryTrace.h
+ * @brief Compact binary trace format: writer and streaming reader.
+ *
+ * Layout (all integers little-endian):
+ * - Header (24 bytes): magic "PSTRACE\0", u32 version, u32 max accesses per
+ *   block, u64 total number of accesses.
+ * - Blocks: u32 payload bytes, u32 access count, then the payload.
+ *   Each access is one LEB128 varint of
+ *   (zigzag(target - previousTarget) << 3 | A << 2 | P << 1 | W), where the
+ *   target is a page ID (A = 0, sign-extended to 64 bits) or a virtual
+ *   address (A = 1) and differences wrap modulo 2^64; the varint may thus
+ *   carry up to 67 bits. If P is set, one byte with the new process ID
+ *   follows. previousTarget and the process ID restart at 0 in every block,
+ *   so each block can be decoded on its own.
+ *   Version 2 (no A bit: zigzag(delta) << 2 | P << 1 | W) and version 1
+ *   (zigzag(delta) << 1 | W) files of page IDs are still read.
+ */
+#ifndef TRACE_BINARYTRACE_H
+#define TRACE_BINARYTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/MemoryAccessEvent.h"
+#include "trace/TraceSource.h"
+
+/**
+ * @brief Writes accesses in the binary trace format.
+ */
+class BinaryTraceWriter {
+public:
+    /// Default number of accesses per independently decodable block.
+    static constexpr std::uint32_t kDefaultBlockAccesses = 1u << 16;
+
+    /**
+     * @brief Create (truncate) a binary trace file.
+     * @param filename Output path.
+     * @param blockAccesses Maximum accesses per block.
+     * @throws std::runtime_error if the file cannot be created or written.
+     */
+    explicit BinaryTraceWriter(const std::string& filename,
+                               std::uint32_t blockAccesses = kDefaultBlockAccesses);
+    ~BinaryTraceWriter();
+
+    BinaryTraceWriter(const BinaryTraceWriter&) = delete;
+    BinaryTraceWriter& operator=(const BinaryTraceWriter&) = delete;
+
+    /** @brief Append one access. */
+    void add(const MemoryAccessEvent& ev) {
+        if (ev.isAddress()) addAddress(ev.address(), ev.write(), ev.processId());
+        else                add(ev.pageId(), ev.write(), ev.processId());
+    }
+
+    /** @brief Append one access to a page ID. */
+    void add(int pageId, bool write, unsigned char processId = 0) {
+        addTarget(static_cast<std::uint64_t>(static_cast<std::int64_t>(pageId)), false, write, processId);
+    }
+
+    /** @brief Append one access to a virtual address. */
+    void addAddress(std::uint64_t address, bool write, unsigned char processId = 0) {
+        addTarget(address, true, write, processId);
+    }
+
+    /**
+     * @brief Append a batch of accesses.
+     * @details Same output as adding them one by one; encodes straight into
+     *          the block buffer, which makes it the fast path for generators.
+     */
+    void add(std::span<const MemoryAccessEvent> events);
+
+    /**
+     * @brief Flush the last block, write the total into the header and close. Idempotent.
+     * @throws std::runtime_error if any write, the header update or the final
+     *         flush failed (e.g. a full disk); the file is then incomplete. The
+     *         destructor reports it on std::cerr instead.
+     */
+    void close();
+
+    /** @return Number of accesses written so far. */
+    std::uint64_t accesses() const { return total_; }
+
+private:
+    void flushBlock();
+    void addTarget(std::uint64_t target, bool address, bool write, unsigned char processId);
+
+    /** @brief Encode one access at @p p (updates the delta base); @return End of the encoding. */
+    unsigned char* encode(unsigned char* p, std::uint64_t target, bool address, bool write,
+                          unsigned char processId) {
+        const bool switched = processId != prevProcess_;
+        const std::uint64_t z = zigzag(target - prevTarget_);
+        prevTarget_  = target;
+        prevProcess_ = processId;
+
+        // LEB128 of (z << 3 | flags) without forming the 67-bit value.
+        const unsigned int flags = (address ? 4u : 0u) | (switched ? 2u : 0u) | (write ? 1u : 0u);
+        std::uint64_t v = z >> 4;
+        *p++ = static_cast<unsigned char>(flags | (z & 0xf) << 3 | (v ? 0x80 : 0));
+        if (v) {
+            while (v >= 0x80) {
+                *p++ = static_cast<unsigned char>(v | 0x80);
+                v >>= 7;
+            }
+            *p++ = static_cast<unsigned char>(v);
+        }
+        if (switched) *p++ = processId;
+        return p;
+    }
+
+    static std::uint64_t zigzag(std::uint64_t delta) {
+        return (delta << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(delta) >> 63);
+    }
+
+    std::string                filename_;
+    std::FILE*                 file_{nullptr};       ///< Null once closed.
+    bool                       writeFailed_{false};  ///< A write failed; reported by close().
+    std::uint32_t              blockAccesses_;
+    std::vector<unsigned char> block_;           ///< Payload buffer, sized for a worst-case block.
+    std::size_t                blockBytes_{0};   ///< Payload bytes of the current block.
+    std::uint32_t              blockCount_{0};   ///< Accesses in the current block.
+    std::uint64_t              prevTarget_{0};   ///< Delta base within the block.
+    unsigned char              prevProcess_{0};  ///< Process of the previous access in the block.
+    std::uint64_t              total_{0};
+};
+
+/**
+ * @brief Streaming reader for binary traces; holds one block in memory at a time.
+ * @details next() throws std::runtime_error, naming the block's file offset,
+ *          for a truncated block or one whose accesses do not fit its payload.
+ */
+class BinaryTraceReader : public TraceSource {
+public:
+    /**
+     * @brief Open a binary trace.
+     * @param filename Path to the file.
+     * @throws std::runtime_error if the file cannot be opened or has a bad header.
+     */
+    explicit BinaryTraceReader(const std::string& filename);
+    ~BinaryTraceReader() override;
+
+    BinaryTraceReader(const BinaryTraceReader&) = delete;
+    BinaryTraceReader& operator=(const BinaryTraceReader&) = delete;
+
+    std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) override;
+
+    /** @return Total number of accesses stored in the file (from the header). */
+    std::uint64_t totalAccesses() const { return total_; }
+
+    /**
+     * @brief Check whether a file starts with the binary trace magic.
+     * @param filename Path to check.
+     */
+    static bool isBinaryTrace(const std::string& filename);
+
+private:
+    bool loadBlock();
+    [[noreturn]] void corrupt(const char* what) const;
+    template <int kFlagBits>
+    std::size_t decode(std::vector<MemoryAccessEvent>& out, std::size_t take);
+
+    std::string                filename_;
+    std::FILE*                 file_{nullptr};
+    std::uint64_t              total_{0};
+    std::uint32_t              version_{0};
+    std::vector<unsigned char> block_;         ///< Payload of the current block.
+    const unsigned char*       pos_{nullptr};  ///< Decode cursor in block_.
+    const unsigned char*       end_{nullptr};  ///< End of block_ payload.
+    std::uint32_t              remaining_{0};  ///< Accesses left in the current block.
+    std::uint64_t              blockOffset_{0};     ///< File offset of the current block header.
+    std::uint64_t              nextBlockOffset_{0}; ///< File offset of the next block header.
+    std::uint64_t              prevTarget_{0};
+    unsigned char              prevProcess_{0};
+};
+
+#endif // TRACE_BINARYTRACE_H
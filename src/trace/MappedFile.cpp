@@ -0,0 +1,85 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Platform-specific implementation of MappedFile.
+ */
+#include "trace/MappedFile.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open file: " + filename);
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(file, &sz)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot stat file: " + filename);
+    }
+    size_ = static_cast<std::size_t>(sz.QuadPart);
+    if (size_ > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open file: " + filename);
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + filename);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            data_ = static_cast<const char*>(p);
+            ::madvise(p, size_, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(fd);
+#endif
+    if (size_ > 0 && !data_) throw std::runtime_error("Cannot map file: " + filename);
+}
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void MappedFile::release() noexcept {
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    ::munmap(const_cast<char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ */
+#ifndef TRACE_MAPPEDFILE_H
+#define TRACE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief RAII read-only view of a file mapped into memory.
+ * @details Uses mmap on POSIX systems and a file mapping on Windows.
+ *          An empty file yields a valid object with size() == 0.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Map a file.
+     * @param filename Path to the file.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /** @return First byte of the mapping (nullptr for empty files). */
+    const char* data() const { return data_; }
+    /** @return Size of the file in bytes. */
+    std::size_t size() const { return size_; }
+    /** @return One past the last byte. */
+    const char* end() const { return data_ + size_; }
+
+private:
+    void release() noexcept;
+
+    const char* data_{nullptr};
+    std::size_t size_{0};
+};
+
+#endif // TRACE_MAPPEDFILE_H
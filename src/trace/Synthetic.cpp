@@ -0,0 +1,189 @@
+/**
+ * @file Synthetic.cpp
+ * @brief Implementation of the synthetic workload generators.
+ */
+#include "trace/Synthetic.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+SyntheticSource::SyntheticSource(const SyntheticOptions& options)
+    : state_(options.seed), remaining_(options.accesses), processId_(options.processId)
+{
+    if (!(options.writeRatio >= 0.0 && options.writeRatio <= 1.0)) {
+        throw std::invalid_argument("SyntheticSource: write ratio must be in [0,1]");
+    }
+    writeAll_       = options.writeRatio == 1.0;
+    writeThreshold_ = writeAll_ ? 0 : static_cast<std::uint64_t>(options.writeRatio * 0x1.0p64);
+}
+
+// ---------------- Zipf ----------------
+
+namespace {
+
+/// log1p(x) / x, accurate near 0.
+double helper1(double x) {
+    return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+/// expm1(x) / x, accurate near 0.
+double helper2(double x) {
+    return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+}
+
+} // namespace
+
+ZipfSource::ZipfSource(int pages, double skew, const SyntheticOptions& options)
+    : SyntheticSource(options), pages_(pages), skew_(skew)
+{
+    if (pages < 1) throw std::invalid_argument("ZipfSource: pages must be >= 1");
+    if (!(skew >= 0.0)) throw std::invalid_argument("ZipfSource: skew must be >= 0");
+    hIntegralX1_ = hIntegral(1.5) - 1.0;
+    hIntegralN_  = hIntegral(pages + 0.5);
+    s_           = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+}
+
+double ZipfSource::h(double x) const { return std::exp(-skew_ * std::log(x)); }
+
+double ZipfSource::hIntegral(double x) const {
+    const double logX = std::log(x);
+    return helper2((1.0 - skew_) * logX) * logX;
+}
+
+double ZipfSource::hIntegralInverse(double x) const {
+    double t = x * (1.0 - skew_);
+    if (t < -1.0) t = -1.0; // rounding at the lower end
+    return std::exp(helper1(t) * x);
+}
+
+int ZipfSource::sample() {
+    for (;;) {
+        const double u = hIntegralN_ + uniform() * (hIntegralX1_ - hIntegralN_);
+        const double x = hIntegralInverse(u);
+        double k = std::floor(x + 0.5);
+        if (k < 1.0) k = 1.0;
+        else if (k > pages_) k = pages_;
+        if (k - x <= s_ || u >= hIntegral(k + 0.5) - h(k)) return static_cast<int>(k) - 1;
+    }
+}
+
+std::size_t ZipfSource::next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) {
+    return produce(out, maxCount, [this](std::uint64_t) { return sample(); });
+}
+
+// ---------------- Scan, loop, phase ----------------
+
+ScanSource::ScanSource(int pages, int run, const SyntheticOptions& options)
+    : SyntheticSource(options), pages_(pages), run_(run)
+{
+    if (pages < 1 || run < 1) throw std::invalid_argument("ScanSource: pages and run must be >= 1");
+}
+
+std::size_t ScanSource::next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) {
+    return produce(out, maxCount, [this](std::uint64_t i) {
+        return static_cast<int>(i / std::uint64_t(run_) % std::uint64_t(pages_));
+    });
+}
+
+LoopSource::LoopSource(int pages, const SyntheticOptions& options)
+    : SyntheticSource(options), pages_(pages)
+{
+    if (pages < 1) throw std::invalid_argument("LoopSource: pages must be >= 1");
+}
+
+std::size_t LoopSource::next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) {
+    return produce(out, maxCount, [this](std::uint64_t i) { return static_cast<int>(i % std::uint64_t(pages_)); });
+}
+
+PhaseSource::PhaseSource(int pages, int workingSet, std::uint64_t phaseLength,
+                         const SyntheticOptions& options)
+    : SyntheticSource(options), pages_(pages), workingSet_(workingSet), phaseLength_(phaseLength)
+{
+    if (workingSet < 1 || workingSet > pages || phaseLength < 1) {
+        throw std::invalid_argument("PhaseSource: need 1 <= workingSet <= pages and phaseLength >= 1");
+    }
+}
+
+std::size_t PhaseSource::next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) {
+    return produce(out, maxCount, [this](std::uint64_t i) {
+        if (i % phaseLength_ == 0) base_ = static_cast<int>(below(std::uint64_t(pages_ - workingSet_) + 1));
+        return base_ + static_cast<int>(below(std::uint64_t(workingSet_)));
+    });
+}
+
+// ---------------- Spec parser ----------------
+
+std::unique_ptr<TraceSource> makeSyntheticTrace(const std::string& spec) {
+    const auto fail = [&](const std::string& why) {
+        return std::invalid_argument("makeSyntheticTrace: " + why + " in '" + spec + "'");
+    };
+    const std::size_t colon = spec.find(':');
+    const std::string kind  = spec.substr(0, colon);
+
+    std::map<std::string, double> values;
+    if (colon != std::string::npos) {
+        std::size_t pos = colon + 1;
+        while (pos < spec.size()) {
+            std::size_t end = spec.find(',', pos);
+            if (end == std::string::npos) end = spec.size();
+            const std::string item = spec.substr(pos, end - pos);
+            const std::size_t eq = item.find('=');
+            if (eq == std::string::npos) throw fail("expected key=value, got '" + item + "'");
+            std::size_t used = 0;
+            double v = 0;
+            try {
+                v = std::stod(item.substr(eq + 1), &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != item.size() - eq - 1) throw fail("bad number '" + item + "'");
+            values[item.substr(0, eq)] = v;
+            pos = end + 1;
+        }
+    }
+    const auto take = [&](const char* key, double fallback) {
+        const auto it = values.find(key);
+        if (it == values.end()) return fallback;
+        const double v = it->second;
+        values.erase(it);
+        if (!std::isfinite(v)) throw fail("'" + std::string(key) + "' must be finite");
+        return v;
+    };
+    // Integer keys are range-checked here: casting an out-of-range double is undefined.
+    constexpr double kMaxU64 = 0x1p64 - 0x1p11; // largest double below 2^64
+    const auto integer = [&](const char* key, double fallback, double lo, double hi) {
+        const double v = take(key, fallback);
+        if (v != std::floor(v) || v < lo || v > hi) {
+            throw fail("'" + std::string(key) + "' must be an integer in [" + std::to_string(std::uint64_t(lo))
+                       + ", " + std::to_string(std::uint64_t(hi)) + "]");
+        }
+        return v;
+    };
+    constexpr double kMaxInt = std::numeric_limits<int>::max();
+
+    SyntheticOptions opt;
+    opt.accesses   = static_cast<std::uint64_t>(integer("accesses", double(opt.accesses), 1, kMaxU64));
+    opt.seed       = static_cast<std::uint64_t>(integer("seed", double(opt.seed), 0, kMaxU64));
+    opt.writeRatio = take("writes", opt.writeRatio);
+    opt.processId  = static_cast<unsigned char>(integer("pid", 0, 0, 255));
+    const int pages = static_cast<int>(integer("pages", 65536, 1, kMaxInt));
+
+    std::unique_ptr<TraceSource> source;
+    if (kind == "zipf") {
+        source = std::make_unique<ZipfSource>(pages, take("skew", 0.99), opt);
+    } else if (kind == "scan") {
+        source = std::make_unique<ScanSource>(pages, static_cast<int>(integer("run", 1, 1, kMaxInt)), opt);
+    } else if (kind == "loop") {
+        source = std::make_unique<LoopSource>(pages, opt);
+    } else if (kind == "phase") {
+        const int set = static_cast<int>(integer("set", pages / 16 ? pages / 16 : 1, 1, pages));
+        source = std::make_unique<PhaseSource>(
+            pages, set, static_cast<std::uint64_t>(integer("phase", 100000, 1, kMaxU64)), opt);
+    } else {
+        throw fail("unknown generator '" + kind + "'");
+    }
+    if (!values.empty()) throw fail("unknown key '" + values.begin()->first + "'");
+    return source;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file Synthetic.h
+ * @brief Seeded synthetic workloads, generated lazily as trace sources.
+ *
+ * Typical usage:
+ * @code{.cpp}
+ * SyntheticOptions opt;
+ * opt.accesses   = 100'000'000;
+ * opt.writeRatio = 0.3;
+ * ZipfSource zipf(1 << 20, 0.99, opt);     // or openTrace("synthetic:zipf:pages=1048576,skew=0.99")
+ * runTrace(zipf, sim);
+ * @endcode
+ */
+#ifndef TRACE_SYNTHETIC_H
+#define TRACE_SYNTHETIC_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/MemoryAccessEvent.h"
+#include "trace/TraceSource.h"
+
+/** @brief Settings shared by all generators. */
+struct SyntheticOptions {
+    std::uint64_t accesses{1'000'000}; ///< Length of the stream.
+    std::uint64_t seed{1};             ///< Same seed, same stream.
+    double        writeRatio{0.0};     ///< Fraction of writes in [0,1].
+    unsigned char processId{0};        ///< Process ID of every access.
+};
+
+/**
+ * @brief Base of the generators: length, seeded RNG and read/write mix.
+ * @details Accesses are produced on demand into the caller's buffer; no
+ *          generator stores the stream. The page of each access is drawn
+ *          before its write flag, from one splitmix64 stream per source, so
+ *          the output depends only on the parameters and the seed.
+ */
+class SyntheticSource : public TraceSource {
+public:
+    /** @return Accesses not yet produced. */
+    std::uint64_t remaining() const { return remaining_; }
+
+protected:
+    /** @throws std::invalid_argument if the write ratio is outside [0,1]. */
+    explicit SyntheticSource(const SyntheticOptions& options);
+
+    /** @return Next 64 random bits. */
+    std::uint64_t random() {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    /** @return Uniform double in [0,1). */
+    double uniform() { return double(random() >> 11) * 0x1.0p-53; }
+    /** @return Uniform integer in [0, n) (bias below n / 2^64). */
+    std::uint64_t below(std::uint64_t n) { return random() % n; }
+
+    /** @brief Append up to @p maxCount accesses with pages from @p page (index -> page ID). */
+    template <class PageFn>
+    std::size_t produce(std::vector<MemoryAccessEvent>& out, std::size_t maxCount, PageFn&& page) {
+        const std::size_t take = static_cast<std::size_t>(std::min<std::uint64_t>(maxCount, remaining_));
+        out.reserve(out.size() + take);
+        for (std::size_t k = 0; k < take; ++k) {
+            const int  p = page(position_ + k);
+            const bool w = writeAll_ || (writeThreshold_ && random() < writeThreshold_);
+            out.emplace_back(p, w, processId_);
+        }
+        position_  += take;
+        remaining_ -= take;
+        return take;
+    }
+
+private:
+    std::uint64_t state_;
+    std::uint64_t position_{0};
+    std::uint64_t remaining_;
+    std::uint64_t writeThreshold_{0}; ///< Write if a random word is below it.
+    bool          writeAll_{false};
+    unsigned char processId_;
+};
+
+/**
+ * @brief Zipf-distributed pages: page k-1 has weight 1/k^skew.
+ * @details Sampled in O(1) expected time by rejection-inversion (Hörmann
+ *          and Derflinger), so no table of @p pages weights is built. Page 0
+ *          is the most popular; skew 0 is uniform, around 1 is typical of
+ *          caches.
+ */
+class ZipfSource final : public SyntheticSource {
+public:
+    /** @throws std::invalid_argument unless pages >= 1 and skew >= 0. */
+    ZipfSource(int pages, double skew, const SyntheticOptions& options = {});
+
+    std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) override;
+
+private:
+    int sample();
+    double h(double x) const;
+    double hIntegral(double x) const;
+    double hIntegralInverse(double x) const;
+
+    int    pages_;
+    double skew_;
+    double hIntegralX1_;
+    double hIntegralN_;
+    double s_;
+};
+
+/**
+ * @brief Sequential scan over [0, pages), wrapping around.
+ * @details Each page is accessed @p run times in a row (e.g. the cache lines
+ *          of a page); with run 1 and pages > frames nothing is ever reused
+ *          before eviction under LRU or FIFO.
+ */
+class ScanSource final : public SyntheticSource {
+public:
+    /** @throws std::invalid_argument unless pages >= 1 and run >= 1. */
+    ScanSource(int pages, int run = 1, const SyntheticOptions& options = {});
+
+    std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) override;
+
+private:
+    int pages_;
+    int run_;
+};
+
+/**
+ * @brief Cyclic loop over [0, pages).
+ * @details A loop just larger than memory (pages = frames + 1) makes LRU and
+ *          FIFO fault on every access, while OPT keeps frames - 1 pages hit.
+ */
+class LoopSource final : public SyntheticSource {
+public:
+    /** @throws std::invalid_argument unless pages >= 1. */
+    explicit LoopSource(int pages, const SyntheticOptions& options = {});
+
+    /** @return Loop one page larger than @p frames. */
+    static LoopSource justLargerThan(int frames, const SyntheticOptions& options = {}) {
+        return LoopSource(frames + 1, options);
+    }
+
+    std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) override;
+
+private:
+    int pages_;
+};
+
+/**
+ * @brief Working set that moves every phase.
+ * @details Accesses are uniform over a window of @p workingSet pages. Every
+ *          @p phaseLength accesses the window jumps to a random offset in
+ *          [0, pages), so the policy has to drop the old set and load the new.
+ */
+class PhaseSource final : public SyntheticSource {
+public:
+    /** @throws std::invalid_argument unless 1 <= workingSet <= pages and phaseLength >= 1. */
+    PhaseSource(int pages, int workingSet, std::uint64_t phaseLength,
+                const SyntheticOptions& options = {});
+
+    std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) override;
+
+private:
+    int           pages_;
+    int           workingSet_;
+    std::uint64_t phaseLength_;
+    int           base_{0};
+};
+
+/**
+ * @brief Create a generator from a text spec.
+ * @details Spec: "<kind>:key=value,key=value,...". Kinds and their keys:
+ *          - zipf:  pages, skew (default 0.99)
+ *          - scan:  pages, run (default 1)
+ *          - loop:  pages
+ *          - phase: pages, set (working set), phase (accesses per phase)
+ *          All kinds also take accesses, seed, writes (ratio) and pid.
+ *          Numbers may use exponent notation (accesses=1e8). Every value
+ *          must be finite; accesses, seed, pid, pages, run, set and phase
+ *          must be integers with pages, run, set, phase >= 1, set <= pages,
+ *          accesses >= 1 and pid <= 255.
+ * @throws std::invalid_argument for unknown kinds, keys or bad values; a bad
+ *         value's message names its key.
+ */
+std::unique_ptr<TraceSource> makeSyntheticTrace(const std::string& spec);
+
+#endif // TRACE_SYNTHETIC_H
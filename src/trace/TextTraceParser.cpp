@@ -0,0 +1,99 @@
+/**
+ * @file TextTraceParser.cpp
+ * @brief Implementation of the memory-mapped text trace parser.
+ */
+#include "trace/TextTraceParser.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+constexpr std::size_t kMaxReportedErrors = 10;
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// "0x" starts an address even without digits, so a bare "0x" is malformed rather than page 0.
+inline bool isHexPrefix(const char* p, const char* end) {
+    return end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X');
+}
+
+} // namespace
+
+TextTraceParser::TextTraceParser(const std::string& filename)
+    : filename_(filename), file_(filename), pos_(file_.data()) {}
+
+std::size_t TextTraceParser::next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) {
+    const char* p   = pos_;
+    const char* end = file_.end();
+    std::size_t n = 0;
+
+    while (n < maxCount && p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        ++line_;
+
+        const char* s = p;
+        p = eol + (eol < end ? 1 : 0);
+
+        while (s < eol && isBlank(*s)) ++s;
+        if (s == eol || *s == '#') continue;
+
+        // "[pid:]target": the first number is the page ID unless a ':' follows.
+        unsigned char processId = 0;
+        bool          isAddress = false;
+        std::uint64_t address   = 0;
+        int           pageId    = 0;
+        std::from_chars_result r{s, std::errc{}};
+        if (!isHexPrefix(s, eol)) {
+            r = std::from_chars((*s == '+') ? s + 1 : s, eol, pageId);
+            if (r.ec == std::errc{} && r.ptr < eol && *r.ptr == ':') {
+                if (pageId < 0 || pageId > 255) {
+                    reportMalformed(s, eol);
+                    continue;
+                }
+                processId = static_cast<unsigned char>(pageId);
+                const char* num = r.ptr + 1;
+                if (isHexPrefix(num, eol)) {
+                    isAddress = true;
+                    r = std::from_chars(num + 2, eol, address, 16);
+                } else {
+                    r = std::from_chars(num, eol, pageId);
+                }
+            }
+        } else {
+            isAddress = true;
+            r = std::from_chars(s + 2, eol, address, 16);
+        }
+        if (r.ec != std::errc{}) {
+            reportMalformed(s, eol);
+            continue;
+        }
+
+        const char* t = r.ptr;
+        while (t < eol && isBlank(*t)) ++t;
+        const bool write = (t < eol) && (*t == 'W' || *t == 'w');
+
+        if (isAddress) out.push_back(MemoryAccessEvent::atAddress(address, write, processId));
+        else           out.emplace_back(pageId, write, processId);
+        ++n;
+    }
+
+    pos_ = p;
+    return n;
+}
+
+void TextTraceParser::reportMalformed(const char* begin, const char* end) {
+    if (malformed_++ < kMaxReportedErrors) {
+        while (end > begin && isBlank(end[-1])) --end;
+        std::cerr << filename_ << ':' << line_ << ": malformed trace line \""
+                  << std::string_view(begin, end - begin) << "\" skipped\n";
+    } else if (malformed_ == kMaxReportedErrors + 1) {
+        std::cerr << filename_ << ": further malformed lines are not reported\n";
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file TextTraceParser.h
+ * @brief Allocation-free parser for text traces on a memory-mapped file.
+ */
+#ifndef TRACE_TEXTTRACEPARSER_H
+#define TRACE_TEXTTRACEPARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "core/MemoryAccessEvent.h"
+#include "trace/MappedFile.h"
+#include "trace/TraceSource.h"
+
+/**
+ * @brief Streaming parser for the text trace format.
+ * @details Format per line: "[pid:]target [R|W]"; blank lines and lines starting
+ *          with '#' (after leading whitespace) are ignored. The target is a
+ *          decimal page ID or a hexadecimal virtual address with a "0x" prefix
+ *          (see MemoryAccessEvent::atAddress). The optional "pid:" prefix
+ *          (0..255) names the issuing process and defaults to 0. The first
+ *          non-blank character after the target selects the access type
+ *          ('W'/'w' = write, anything else = read); the rest of the line is
+ *          ignored. The file is memory-mapped and scanned in place with
+ *          std::from_chars, so parsing performs no per-line allocation.
+ *
+ *          Lines that do not start with a page ID or address (including a
+ *          "0x" without valid hex digits, or one that overflows 64 bits) or
+ *          whose process ID is out of range are skipped and
+ *          reported on std::cerr as "file:line: ..." (the first few only);
+ *          see @ref malformedLines for the total.
+ */
+class TextTraceParser : public TraceSource {
+public:
+    /**
+     * @brief Map a trace file for parsing.
+     * @param filename Path to the trace file.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit TextTraceParser(const std::string& filename);
+
+    /**
+     * @brief Parse up to @p maxCount further accesses.
+     * @param out Receives the accesses (appended).
+     * @param maxCount Maximum number of accesses to append.
+     * @return Number of accesses appended; 0 once the file is exhausted.
+     */
+    std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) override;
+
+    /** @return True once the whole file has been consumed. */
+    bool done() const { return pos_ >= file_.end(); }
+
+    /** @return Number of lines consumed so far (1-based line of the last parsed line). */
+    std::size_t lineNumber() const { return line_; }
+
+    /** @return Number of malformed lines skipped so far. */
+    std::size_t malformedLines() const { return malformed_; }
+
+    /** @return Size of the trace file in bytes. */
+    std::size_t bytes() const { return file_.size(); }
+
+private:
+    void reportMalformed(const char* begin, const char* end);
+
+    std::string filename_;
+    MappedFile  file_;
+    const char* pos_{nullptr};
+    std::size_t line_{0};
+    std::size_t malformed_{0};
+};
+
+#endif // TRACE_TEXTTRACEPARSER_H
@@ -0,0 +1,31 @@
+/**
+ * @file TraceSource.h
+ * @brief Common interface of all streaming trace readers.
+ */
+#ifndef TRACE_TRACESOURCE_H
+#define TRACE_TRACESOURCE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "core/MemoryAccessEvent.h"
+
+/**
+ * @brief A stream of memory accesses that is consumed chunk by chunk.
+ * @details Implementations never materialize the whole trace; callers pull
+ *          accesses into a reusable buffer until @ref next returns 0.
+ */
+class TraceSource {
+public:
+    virtual ~TraceSource() = default;
+
+    /**
+     * @brief Produce up to @p maxCount further accesses.
+     * @param out Receives the accesses (appended).
+     * @param maxCount Maximum number of accesses to append.
+     * @return Number of accesses appended; 0 once the stream is exhausted.
+     */
+    virtual std::size_t next(std::vector<MemoryAccessEvent>& out, std::size_t maxCount) = 0;
+};
+
+#endif // TRACE_TRACESOURCE_H
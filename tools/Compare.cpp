@@ -0,0 +1,97 @@
+/**
+ * @file Compare.cpp
+ * @brief Compare replacement algorithms side by side in one pass over a trace.
+ *
+ * Usage: PagingCompare <trace> [options]
+ * - --algorithms a,b,..  Algorithms to compare (default: all, see pagingAlgorithmNames()).
+ * - --frames n           Physical frames (default 64).
+ * - --tlb n              TLB capacity, 0 = no TLB (default 16).
+ * - --threads n          1 = single thread (default), 0 = one per algorithm.
+ * - --chunk n            Accesses decoded per chunk (default 4096).
+ * - --pages n            Page-table size of each process (default 65536).
+ * - --radix              Use sparse radix page tables (for large address traces).
+ * - --opt                Add an "opt" column: Belady's optimum, the fault lower
+ *                        bound. Needs a next-use index of the trace, which is
+ *                        cached in <trace>.nextuse; every access must fit --pages.
+ * The trace is read and parsed once; every chunk goes to all simulations.
+ */
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TraceLoader.h"
+#include "analysis/NextUseIndex.h"
+#include "core/algorithms/OPTAlgorithm.h"
+#include "sweep/Lockstep.h"
+#include "sweep/Sweep.h"
+
+int main(int argc, char** argv) {
+    std::string              trace;
+    std::vector<std::string> algorithms = pagingAlgorithmNames();
+    int                      frames = 64;
+    int                      tlb = 16;
+    unsigned                 threads = 1;
+    std::size_t              chunk = 4096;
+    std::uint64_t            pages = 1 << 16;
+    PageTableKind            kind = PageTableKind::Dense;
+    bool                     opt = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--radix")                       kind = PageTableKind::Radix;
+            else if (arg == "--opt")                    opt = true;
+            else if (arg == "--algorithms" && hasValue) {
+                algorithms.clear();
+                std::stringstream ss(argv[++i]);
+                for (std::string a; std::getline(ss, a, ',');) {
+                    if (!a.empty()) algorithms.push_back(a);
+                }
+            }
+            else if (arg == "--frames" && hasValue)     frames = std::stoi(argv[++i]);
+            else if (arg == "--tlb" && hasValue)        tlb = std::stoi(argv[++i]);
+            else if (arg == "--threads" && hasValue)    threads = unsigned(std::stoul(argv[++i]));
+            else if (arg == "--chunk" && hasValue)      chunk = std::stoull(argv[++i]);
+            else if (arg == "--pages" && hasValue)      pages = std::stoull(argv[++i]);
+            else if (trace.empty() && arg.rfind("--", 0) != 0) trace = arg;
+            else throw std::invalid_argument("unexpected argument '" + arg + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        trace.clear();
+    }
+    if (trace.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <trace> [--algorithms a,b] [--frames n] [--tlb n]\n"
+                  << "       [--threads n] [--chunk n] [--pages n] [--radix] [--opt]\n";
+        return 2;
+    }
+
+    try {
+        NextUseIndex index;
+        if (opt) index = NextUseIndex::loadOrBuild(trace);
+
+        LockstepRunner runner(pages, kind);
+        for (const auto& a : algorithms) {
+            runner.add(a, std::make_unique<Simulation>(frames, makePagingAlgorithm(a), tlb));
+        }
+        if (opt) runner.add("opt", std::make_unique<Simulation>(frames, std::make_unique<OPTAlgorithm>(index), tlb));
+        const auto t0 = std::chrono::steady_clock::now();
+        auto source = openTrace(trace);
+        const std::size_t n = runner.run(*source, chunk, threads);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t0;
+
+        runner.writeTable(std::cout);
+        std::cerr << n << " accesses x " << runner.size() << " simulations in "
+                  << elapsed.count() << " s\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
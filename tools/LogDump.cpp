@@ -0,0 +1,24 @@
+/**
+ * @file LogDump.cpp
+ * @brief Render a binary step log (see BinaryEventLog) as text.
+ *
+ * Usage: PagingLogDump <file.pslog>
+ */
+#include <exception>
+#include <iostream>
+
+#include "log/BinaryEventLog.h"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <file.pslog>\n";
+        return 2;
+    }
+    try {
+        renderBinaryEventLog(argv[1], std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
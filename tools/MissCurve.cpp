@@ -0,0 +1,77 @@
+/**
+ * @file MissCurve.cpp
+ * @brief Print the LRU fault curve of a trace: exact, or sampled in bounded memory.
+ *
+ * Usage: PagingMissCurve <trace> [maxFrames] [--page-bytes N] [--sample PAGES]
+ * - Prints CSV "frames,faults,miss_ratio" for 1..maxFrames frames
+ *   (default: up to the number of distinct pages).
+ * - --page-bytes sets the page size used to split address accesses (default 4096).
+ * - --sample estimates the curve from a hashed sample of at most PAGES pages
+ *   (SHARDS) in bounded memory and prints "frames,miss_ratio,error_bound"
+ *   at up to 4096 sizes instead.
+ * - The same numbers are the miss curve of a fully associative LRU TLB.
+ */
+#include <bit>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "TraceLoader.h"
+#include "analysis/Shards.h"
+#include "analysis/StackDistance.h"
+
+int main(int argc, char** argv) {
+    std::string   trace;
+    std::uint64_t maxFrames = 0;
+    std::uint64_t pageBytes = 4096;
+    std::uint64_t samplePages = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--page-bytes" && i + 1 < argc) pageBytes = std::stoull(argv[++i]);
+        else if (arg == "--sample" && i + 1 < argc) samplePages = std::stoull(argv[++i]);
+        else if (trace.empty())                    trace = arg;
+        else                                       maxFrames = std::stoull(arg);
+    }
+    if (trace.empty() || !std::has_single_bit(pageBytes)) {
+        std::cerr << "Usage: " << argv[0] << " <trace> [maxFrames] [--page-bytes N] [--sample PAGES]\n";
+        return 2;
+    }
+
+    try {
+        if (samplePages > 0) {
+            ShardsAnalyzer shards(samplePages, 1.0, std::countr_zero(pageBytes));
+            auto source = openTrace(trace);
+            shards.consume(*source);
+            if (maxFrames == 0) maxFrames = std::uint64_t(shards.estimatedPages()) + 1;
+
+            const std::uint64_t step = (maxFrames + 4095) / 4096;
+            std::vector<std::uint64_t> sizes;
+            for (std::uint64_t f = step; f <= maxFrames; f += step) sizes.push_back(f);
+            std::cout << "frames,miss_ratio,error_bound\n";
+            for (const MissRatioPoint& p : shards.missRatioCurve(sizes)) {
+                std::cout << p.frames << ',' << p.missRatio << ',' << p.errorBound << '\n';
+            }
+            std::cerr << "sampling rate " << shards.samplingRate() << ", "
+                      << shards.samplePages() << " pages in the sample\n";
+            return 0;
+        }
+
+        StackDistanceAnalyzer sd(std::countr_zero(pageBytes));
+        auto source = openTrace(trace);
+        sd.consume(*source);
+        if (maxFrames == 0) maxFrames = sd.distinctPages();
+
+        const auto curve = sd.faultCurve(maxFrames);
+        const double n = sd.accesses() ? double(sd.accesses()) : 1.0;
+        std::cout << "frames,faults,miss_ratio\n";
+        for (std::uint64_t f = 1; f <= maxFrames; ++f) {
+            std::cout << f << ',' << curve[f] << ',' << curve[f] / n << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file Sweep.cpp
+ * @brief Run every combination of algorithms x frame counts x TLB sizes over one trace.
+ *
+ * Usage: PagingSweep <trace> [options]
+ * - --algorithms a,b,..  Replacement algorithms (default: all, see pagingAlgorithmNames()).
+ * - --frames n,..        Physical frame counts (default 16,64,256,1024).
+ * - --tlb n,..           TLB capacities, 0 = no TLB (default 16,64).
+ * - --tlb-ways n         TLB associativity, 0 = fully associative (default 0).
+ * - --tlb-policy p       fifo, lru, random or plru (default fifo).
+ * - --threads n          Worker threads, 0 = all hardware threads (default 0).
+ * - --page-bytes n       Base page size for address traces (default 4096).
+ * - --json               Write JSON instead of CSV.
+ * - --out file           Write the table to a file instead of stdout.
+ * The trace is decoded once; all runs replay the same in-memory copy.
+ */
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TraceLoader.h"
+#include "sweep/Sweep.h"
+
+namespace {
+
+std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> items;
+    std::stringstream ss(s);
+    for (std::string item; std::getline(ss, item, ',');) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+std::vector<int> intList(const std::string& s) {
+    std::vector<int> values;
+    for (const auto& item : splitList(s)) values.push_back(std::stoi(item));
+    return values;
+}
+
+TLBReplacement parsePolicy(const std::string& s) {
+    if (s == "fifo")   return TLBReplacement::FIFO;
+    if (s == "lru")    return TLBReplacement::LRU;
+    if (s == "random") return TLBReplacement::Random;
+    if (s == "plru")   return TLBReplacement::PLRU;
+    throw std::invalid_argument("unknown TLB policy '" + s + "'");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string              trace;
+    std::vector<std::string> algorithms = pagingAlgorithmNames();
+    std::vector<int>         frames{16, 64, 256, 1024};
+    std::vector<int>         tlbSizes{16, 64};
+    unsigned                 ways = 0;
+    TLBReplacement           policy = TLBReplacement::FIFO;
+    unsigned                 threads = 0;
+    std::uint64_t            pageBytes = 4096;
+    bool                     json = false;
+    std::string              out;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--json")                           json = true;
+            else if (arg == "--algorithms" && hasValue)    algorithms = splitList(argv[++i]);
+            else if (arg == "--frames" && hasValue)        frames = intList(argv[++i]);
+            else if (arg == "--tlb" && hasValue)           tlbSizes = intList(argv[++i]);
+            else if (arg == "--tlb-ways" && hasValue)      ways = unsigned(std::stoul(argv[++i]));
+            else if (arg == "--tlb-policy" && hasValue)    policy = parsePolicy(argv[++i]);
+            else if (arg == "--threads" && hasValue)       threads = unsigned(std::stoul(argv[++i]));
+            else if (arg == "--page-bytes" && hasValue)    pageBytes = std::stoull(argv[++i]);
+            else if (arg == "--out" && hasValue)           out = argv[++i];
+            else if (trace.empty() && arg.rfind("--", 0) != 0) trace = arg;
+            else throw std::invalid_argument("unexpected argument '" + arg + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        trace.clear();
+    }
+    if (trace.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <trace> [--algorithms a,b] [--frames n,..] [--tlb n,..]\n"
+                  << "       [--tlb-ways n] [--tlb-policy fifo|lru|random|plru] [--threads n]\n"
+                  << "       [--page-bytes n] [--json] [--out file]\n";
+        return 2;
+    }
+
+    try {
+        for (const auto& a : algorithms) makePagingAlgorithm(a); // reject typos before decoding
+
+        const auto t0 = std::chrono::steady_clock::now();
+        auto source = openTrace(trace);
+        const SharedTrace shared = SharedTrace::decode(*source, pageBytes);
+        const auto t1 = std::chrono::steady_clock::now();
+
+        std::vector<TLBConfig> tlbs;
+        for (int c : tlbSizes) tlbs.push_back(TLBConfig{static_cast<unsigned>(c), ways, policy});
+        const auto configs = sweepGrid(algorithms, frames, tlbs);
+        const auto results = runSweep(shared, configs, threads);
+        const auto t2 = std::chrono::steady_clock::now();
+
+        std::ofstream file;
+        if (!out.empty()) {
+            file.open(out);
+            if (!file) throw std::runtime_error("Cannot create output file: " + out);
+        }
+        std::ostream& os = out.empty() ? std::cout : file;
+        if (json) writeSweepJson(os, results);
+        else      writeSweepCsv(os, results);
+
+        const std::chrono::duration<double> decode = t1 - t0, sweep = t2 - t1;
+        std::cerr << shared.events().size() << " accesses decoded in " << decode.count() << " s, "
+                  << configs.size() << " runs in " << sweep.count() << " s\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
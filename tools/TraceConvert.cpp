@@ -0,0 +1,79 @@
+/**
+ * @file TraceConvert.cpp
+ * @brief Convert traces between the text and the binary format.
+ *
+ * Usage: PagingTraceConvert <input> <output> [--text]
+ * - The input format is detected automatically. An input "synthetic:<spec>"
+ *   writes a generated workload instead (see makeSyntheticTrace), e.g.
+ *   PagingTraceConvert synthetic:zipf:pages=1048576,skew=0.9,accesses=1e9 zipf.bin
+ * - Without --text the output is a binary trace (see BinaryTrace.h),
+ *   with --text it is the usual "[pid:]pageId R|W" text format
+ *   (addresses are written as "[pid:]0x<hex> R|W").
+ */
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "TraceLoader.h"
+#include "trace/BinaryTrace.h"
+
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 4 || (argc == 4 && std::string(argv[3]) != "--text")) {
+        std::cerr << "Usage: " << argv[0] << " <input> <output> [--text]\n";
+        return 2;
+    }
+    const std::string in  = argv[1];
+    const std::string out = argv[2];
+    const bool toText = (argc == 4);
+
+    try {
+        auto source = openTrace(in);
+        std::vector<MemoryAccessEvent> chunk;
+        chunk.reserve(1 << 16);
+        std::uint64_t count = 0;
+
+        if (toText) {
+            std::ofstream os(out);
+            if (!os) throw std::runtime_error("Cannot create trace file: " + out);
+            os << "# [pid:](pageId|0xaddress) [R|W]\n";
+            while (source->next(chunk, 1 << 16) > 0) {
+                for (const auto& ev : chunk) {
+                    if (ev.processId() != 0) os << std::dec << int(ev.processId()) << ':';
+                    if (ev.isAddress()) os << "0x" << std::hex << ev.address();
+                    else                os << std::dec << ev.pageId();
+                    os << (ev.write() ? " W\n" : " R\n");
+                }
+                count += chunk.size();
+                chunk.clear();
+            }
+            os.close();
+            if (!os) throw std::runtime_error("Write error on trace file: " + out);
+        } else {
+            BinaryTraceWriter writer(out);
+            while (source->next(chunk, 1 << 16) > 0) {
+                writer.add(chunk);
+                count += chunk.size();
+                chunk.clear();
+            }
+            writer.close();
+        }
+
+        const auto outBytes = std::filesystem::file_size(out);
+        if (in.rfind(kSyntheticPrefix, 0) == 0) {
+            std::cout << count << " accesses: " << outBytes << " bytes\n";
+        } else {
+            const auto inBytes = std::filesystem::file_size(in);
+            std::cout << count << " accesses: " << inBytes << " -> " << outBytes << " bytes";
+            if (outBytes) std::cout << " (ratio " << double(inBytes) / outBytes << ")";
+            std::cout << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}